@@ -22,16 +22,53 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
+#include <math.h>
+#include <errno.h>
+#include <stdint.h>
 #include <time.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <sys/sysinfo.h>
 #include <sys/statvfs.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <sys/mman.h>
+#include <dirent.h>
 #include <pthread.h>
+#include <stdatomic.h>
 #include <signal.h>
+#include <poll.h>
 #include <sys/wait.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <linux/input.h>
+#include <linux/uinput.h>
+#include <netdb.h>
+#include <sys/signalfd.h>
+#include <sys/syscall.h>
+#include <sys/resource.h>
+#include <spawn.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
 
 #define VERSION "1.0.4"
 
+/* Also close the fonts while an app is in the foreground - resume then reparses them */
+#ifndef TRIM_FONTS
+#define TRIM_FONTS 1
+#endif
+
 /* Arc Blueberry Color Palette */
 #define COL_BG              0x11, 0x14, 0x22, 0xFF
 #define COL_BG_SECONDARY    0x1A, 0x1E, 0x33, 0xFF
@@ -47,12 +84,101 @@
 #define COL_ORANGE          0xFF, 0x95, 0x5C, 0xFF
 #define COL_CYAN            0x69, 0xC3, 0xFF, 0xFF
 
-/* Layout constants */
+/* Layout constants - in design pixels at 1920x1080, multiplied by the display scale */
+#define DESIGN_WIDTH    1920
+#define DESIGN_HEIGHT   1080
+#define SCALE_STEP      0.25f   /* scales are quantized so a resize rarely changes them */
+#define SCALE_MIN       0.5f
+#define SCALE_MAX       4.0f
 #define TILE_WIDTH      140
 #define TILE_HEIGHT     130
 #define TILE_SPACING    20
 #define TILE_RADIUS     16
-#define NUM_APPS        5
+
+/* App grid - the catalog scrolls by rows through a fixed set of on-screen slots */
+#define MAX_APPS            64      /* catalog entries read from apps.conf */
+#define MAX_ARGS            16      /* longer commands run through the shell */
+#define GRID_MAX_COLS       8
+#define GRID_MAX_ROWS       3
+#define GRID_MARGIN         80      /* horizontal overscan margin */
+#define MAX_VISIBLE_TILES   (GRID_MAX_COLS * GRID_MAX_ROWS)
+
+/* Stats sampling */
+#define MAX_CPUS                32
+#define STATS_INTERVAL_MS       2000    /* normal cadence */
+#define STATS_FAST_INTERVAL_MS  500     /* cadence right after user input */
+#define STATS_BOOST_MS          5000    /* how long input keeps the fast cadence */
+#define MAX_SENSORS             8       /* temperature inputs kept open */
+#define MAX_FREQ_POLICIES       8       /* cpufreq policies (CPU clusters) watched */
+#define THROTTLE_BUSY           80      /* core % at which anything under full clock is throttling */
+#define MAX_MOUNTS              8       /* mounts.conf entries watched */
+#define DISK_INTERVAL_MS        30000   /* fullness and mount devices - they change slowly */
+#define PROBE_INTERVAL_MS       10000   /* RTT probe cadence */
+#define PROBE_TIMEOUT_MS        1000    /* per-address connect timeout on the probe thread */
+#define PROBE_BUDGET_MS         3000    /* one probe across all addresses - keeps the RTT fresh */
+#define RTT_WARN_MS             80      /* probe RTT colour thresholds */
+#define RTT_BAD_MS              200
+#define HISTORY_LEN             120     /* samples kept per stat - 4 minutes at the normal cadence */
+#define HISTORY_INTERVAL_MS     STATS_INTERVAL_MS   /* one sparkline column per slot, even when boosted */
+#define SPARK_BAND              24      /* design height of one sparkline */
+#define STAT_WIDTH              145     /* design width of one stats bar entry */
+
+/* Selection animation */
+#define SEL_SETTINGS            MAX_APPS    /* sel_fade[] slot of the settings button */
+#define ANIM_SLIDE_MS           180     /* tile highlight moving to its new tile */
+#define ANIM_FADE_MS            150     /* selection fading in/out */
+#define ANIM_FRAME_MS           16      /* frame pacing when present doesn't wait for VSync */
+#define ANIM_VSYNC_MIN_MS       (ANIM_FRAME_MS / 4)  /* a VSync'd frame faster than this didn't wait */
+#define STARTUP_POLL_MS         100     /* wait timeout while a startup or wallpaper worker runs */
+
+/* Separately invalidated screen regions, one dirty bit each */
+enum {
+    REGION_BACKGROUND,      /* whole screen - forces a full recomposite */
+    REGION_CLOCK,
+    REGION_SETTINGS,
+    REGION_STATS,
+    REGION_MODAL,           /* dialog overlay - composited over the frame, never into it */
+    REGION_TILE_FIRST,      /* one region per on-screen tile slot */
+    NUM_REGIONS = REGION_TILE_FIRST + MAX_VISIBLE_TILES
+};
+
+_Static_assert(NUM_REGIONS <= 32, "dirty mask is a Uint32");
+
+#define REGION_BIT(r)   (1u << (r))
+#define REGION_ALL      ((1u << NUM_REGIONS) - 1)
+#define REGION_TILES    (((1u << MAX_VISIBLE_TILES) - 1) << REGION_TILE_FIRST)
+
+/* Wake event codes - carried in SDL_UserEvent.code of the registered wake event */
+enum {
+    WAKE_STATS,             /* stats thread sampled a changed value */
+    WAKE_CHILD_EXIT,        /* launched app exited, data1 = pid */
+    WAKE_CLOCK,             /* minute boundary reached */
+    WAKE_STARTUP_DONE,      /* startup worker finished rasterizing */
+    WAKE_WARM,              /* idle long enough to start prefetching warm apps */
+    WAKE_WARM_SNAPSHOT,     /* warm app has been up a while, data1 = pid */
+    WAKE_CONTROL,           /* control socket command, data1 = ControlCommand */
+    WAKE_IDLE,              /* no input for a while - dim or blank */
+    WAKE_BACKGROUND,        /* wallpaper re-prepared for a new window size */
+    NUM_WAKE_CODES
+};
+
+/* Confirmation dialogs - MODAL_NONE when the main scene has input */
+enum {
+    MODAL_NONE,
+    MODAL_REBOOT,
+    MODAL_POWEROFF,
+    NUM_MODALS
+};
+
+/* Idle mode - see idle_check() */
+enum {
+    IDLE_NONE,
+    IDLE_DIM,               /* dimmed, drifting clock on black, stats stopped */
+    IDLE_BLANK,             /* black, display powered down if blank.conf says how */
+};
+
+#define DIALOG_W 400
+#define DIALOG_H 180
 
 /* Nerd Font Unicode codepoints */
 #define ICON_TV         "\xEF\x89\xAC"      /* U+F26C */
@@ -65,37 +191,412 @@
 #define ICON_MEMORY     "\xEE\xBF\x85"      /* U+EFC5 */
 #define ICON_TEMP       "\xEF\x8B\x89"      /* U+F2C9 */
 #define ICON_DISK       "\xEF\x82\xA0"      /* U+F0A0 */
+#define ICON_SWAP       "\xEF\x83\xAC"      /* U+F0EC */
+#define ICON_IO         "\xEF\x83\xA4"      /* U+F0E4 */
+#define ICON_NET        "\xEF\x87\xAB"      /* U+F1EB */
+
+/* Glyph atlas slots - digits occupy 0-9 so a digit indexes its own slot */
+enum {
+    GLYPH_COLON = 10,
+    GLYPH_PERCENT,
+    GLYPH_CELSIUS,
+    GLYPH_MBPS,
+    GLYPH_MBITS,
+    GLYPH_ICON_CPU,
+    GLYPH_ICON_MEMORY,
+    GLYPH_ICON_TEMP,
+    GLYPH_ICON_DISK,
+    GLYPH_ICON_IO,
+    GLYPH_ICON_NET,
+    GLYPH_ICON_SWAP,
+    NUM_GLYPHS
+};
+
+static const char *glyph_text[NUM_GLYPHS] = {
+    "0", "1", "2", "3", "4", "5", "6", "7", "8", "9",
+    ":", "%", "°C", "MB/s", "Mb/s",
+    ICON_CPU, ICON_MEMORY, ICON_TEMP, ICON_DISK, ICON_IO, ICON_NET, ICON_SWAP,
+};
+
+/* Stats bar entries, left to right - same order as their GLYPH_ICON_* slots */
+enum {
+    STAT_CPU,
+    STAT_MEM,
+    STAT_TEMP,
+    STAT_DISK,
+    STAT_IO,                    /* shows MB/s, coloured and graphed by utilization */
+    STAT_NET,                   /* shows Mbit/s, coloured by probe RTT */
+    STAT_SWAP,
+    NUM_STATS
+};
+
+/* Stat severity levels, one atlas color each */
+enum {
+    LEVEL_GREEN,
+    LEVEL_YELLOW,
+    LEVEL_ORANGE,
+    LEVEL_RED,
+    NUM_LEVELS
+};
 
 /* App configuration */
 typedef struct {
     const char *name;
     const char *command;
     const char *icon;
+    int warm;                   /* prefetch its files into the page cache while idle */
+    char *const *argv;          /* pre-split for posix_spawnp, NULL = run through /bin/sh */
 } App;
 
-static const App apps[NUM_APPS] = {
-    {"Kodi",      "kodi",                              ICON_TV},
-    {"Stremio",   "/home/aleksa/.local/bin/stremio",   ICON_PLAY},
-    {"IPTV",      "/home/aleksa/omarchy-iptv",         ICON_VIDEO},
-    {"Tidal",     "tidal-hifi",                        ICON_MUSIC},
-    {"Bluetooth", "blueman-manager",                   ICON_BLUETOOTH},
+/* Eased transition of one value, timed with SDL_GetTicks() */
+typedef struct {
+    float from;
+    float to;
+    Uint32 start;
+    Uint32 duration;    /* 0 = settled at to */
+    int active;         /* still needs frames - cleared once the final value was drawn */
+} Tween;
+
+/* Action behind a confirmation dialog */
+typedef struct {
+    const char *title;
+    const char *command;
+} ModalAction;
+
+/* Pre-rasterized glyph strip for one font/color pair */
+typedef struct {
+    SDL_Texture *texture;
+    SDL_Rect cells[NUM_GLYPHS];
+    int height;
+} GlyphAtlas;
+
+/* Used when there is no apps.conf - a leading $HOME is expanded when the command is split */
+static const App default_apps[] = {
+    {"Kodi",      "kodi",                              ICON_TV,        1, NULL},
+    {"Stremio",   "$HOME/.local/bin/stremio",          ICON_PLAY,      1, NULL},
+    {"IPTV",      "$HOME/omarchy-iptv",                ICON_VIDEO,     0, NULL},
+    {"Tidal",     "tidal-hifi",                        ICON_MUSIC,     0, NULL},
+    {"Bluetooth", "blueman-manager",                   ICON_BLUETOOTH, 0, NULL},
 };
 
-/* System stats */
+#define NUM_DEFAULT_APPS ((int)(sizeof(default_apps) / sizeof(default_apps[0])))
+
+/* Runtime app list - the App table and every string it points to share one block */
+typedef struct {
+    void *block;
+    App *apps;
+    int num_apps;
+    int max_apps;
+    char *strings;
+    size_t strings_used;
+    size_t strings_size;
+} Catalog;
+
+/* Label and icon textures for one catalog entry, kept only while it is on screen */
+typedef struct {
+    int app;                /* catalog index, -1 if the slot is free */
+    SDL_Texture *label;
+    SDL_Texture *icon;
+    SDL_Texture *icon_dim;
+} TileTextures;
+
+static const ModalAction modal_actions[NUM_MODALS] = {
+    [MODAL_REBOOT]   = {"Reboot?",    "sudo reboot"},
+    [MODAL_POWEROFF] = {"Power Off?", "sudo poweroff"},
+};
+
+/* One consistent set of readings */
 typedef struct {
     int cpu;
     int mem;
     int temp;
-    int disk;
-    volatile int changed;
-    volatile int running;
+    int disk;                   /* fullest watched mount */
+    int swap;                   /* percent of swap in use, 0 without swap */
+    int throttled;              /* CPU clock held below its limit */
+    int io_mbps;                /* read + write across the watched mounts' devices */
+    int io_util;                /* percent of time the busiest of them had I/O in flight */
+    int net_mbits;              /* rx + tx over the non-loopback interfaces */
+    int net_rtt;                /* ms to the probe host, 0 = no probe, -1 = unreachable */
+    int ncpu;                   /* valid entries in cpu_core */
+    int cpu_core[MAX_CPUS];
+    Uint64 timestamp;           /* CLOCK_MONOTONIC ms when sampled, 0 = never */
+    Uint32 columns;             /* sparkline columns due so far - see HISTORY_INTERVAL_MS */
+} StatsSample;
+
+/*
+ * Recent samples for the sparklines, one array per STAT_* in 0-100 (NET
+ * is Mbit/s, clipped at 100). Slot count % HISTORY_LEN is the next one
+ * written, which is also the sparkline texture column it lands in. Main
+ * thread only.
+ */
+typedef struct {
+    Uint8 values[NUM_STATS][HISTORY_LEN];
+    Uint32 count;               /* samples ever appended */
+    Uint32 columns;             /* StatsSample.columns of the last one */
+} StatsHistory;
+
+/*
+ * Seqlock-published copy of the latest StatsSample. The stats thread is
+ * the only writer; readers never block and retry if a write overlapped.
+ * Every field is atomic so concurrent access is race-free in the C11 model.
+ */
+typedef struct {
+    atomic_uint seq;            /* odd while a write is in progress */
+    atomic_int cpu;
+    atomic_int mem;
+    atomic_int temp;
+    atomic_int disk;
+    atomic_int swap;
+    atomic_int throttled;
+    atomic_int io_mbps;
+    atomic_int io_util;
+    atomic_int net_mbits;
+    atomic_int net_rtt;
+    atomic_int ncpu;
+    atomic_int cpu_core[MAX_CPUS];
+    _Atomic Uint64 timestamp;
+} StatsSeqlock;
+
+/* System stats */
+typedef struct {
+    StatsSeqlock published;
+
+    /* Scheduler state, guarded by lock */
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    int running;
+    int paused;                 /* app in foreground - nobody sees the stats */
+    int kick;                   /* sample now instead of waiting out the interval */
+    struct timespec boost_until;
 } Stats;
 
+/* Cumulative jiffies of one /proc/stat cpu line */
+typedef struct {
+    unsigned long long idle;
+    unsigned long long total;
+} CpuTimes;
+
+/* /proc/meminfo fields wanted, in kB - indexes into ProcSampler.meminfo */
+enum {
+    MEMINFO_TOTAL,
+    MEMINFO_FREE,
+    MEMINFO_AVAILABLE,
+    MEMINFO_BUFFERS,
+    MEMINFO_CACHED,
+    MEMINFO_SWAP_TOTAL,
+    MEMINFO_SWAP_FREE,
+    NUM_MEMINFO
+};
+
+/* Block device behind a watched mount, with its last /proc/diskstats counters */
+typedef struct {
+    unsigned int major, minor;
+    unsigned long long sectors;     /* read + written, 512-byte units */
+    unsigned long long io_ticks;    /* ms with I/O in flight */
+    int seen;                       /* counters above are valid */
+} BlockDev;
+
+/*
+ * TCP connect time to probe.conf's host, measured on a thread of its own
+ * so a dead resolver or route never holds up the other stats. The
+ * thread is detached - a lookup can block for seconds - and the last of
+ * it and the sampler to let go frees this.
+ */
+typedef struct {
+    char host[256];
+    char port[16];
+    pthread_t thread;
+    int started;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    int pending;                /* probe requested by the stats thread */
+    int stop;
+    int refs;
+    atomic_int rtt;             /* ms, 0 = none yet, -1 = unreachable */
+    struct addrinfo *addrs;     /* probe thread only, NULL until resolved */
+    struct timespec due;        /* stats thread only */
+} NetProbe;
+
+/* Persistent /proc readers - opened once, re-read with pread() each tick */
+typedef struct {
+    int stat_fd;
+    int meminfo_fd;
+    int thermal_fd[MAX_SENSORS];    /* hottest one is the reading */
+    int num_thermal;
+    int freq_cur_fd[MAX_FREQ_POLICIES];
+    int freq_cap_fd[MAX_FREQ_POLICIES];
+    unsigned long long freq_base[MAX_FREQ_POLICIES];   /* kHz, scaling_max_freq at startup */
+    Uint32 freq_cpus[MAX_FREQ_POLICIES];                /* bit n = cpuN is in the policy */
+    int num_freq;
+    int throttle_fd[MAX_CPUS + 1];  /* x86 thermal_throttle counters, per core plus package */
+    int num_throttle;
+    unsigned long long throttle_events;     /* their sum at the last tick */
+    int cooling_fd[MAX_SENSORS];    /* cur_state of the CPU cooling devices */
+    int num_cooling;
+    int diskstats_fd;
+    char *diskstats_buf;            /* grown to fit, loop and dm devices can make it long */
+    size_t diskstats_size;
+    char mounts[MAX_MOUNTS][256];
+    int num_mounts;
+    BlockDev devs[MAX_MOUNTS];
+    int num_devs;
+    struct timespec disk_due;       /* next fullness and device refresh */
+    struct timespec io_last;        /* when devs[] counters were read */
+    int netdev_fd;
+    unsigned long long net_bytes;   /* rx + tx at net_last, 0 before the first read */
+    struct timespec net_last;
+    NetProbe *probe;                /* NULL without probe.conf */
+    CpuTimes prev[MAX_CPUS + 1];    /* [0] aggregate, [1 + n] cpuN */
+} ProcSampler;
+
+/* Rasterized surface waiting for its GPU upload on the render thread */
+typedef struct {
+    SDL_Surface *surface;
+    SDL_Texture **texture;
+} PendingUpload;
+
+#define MAX_PENDING_UPLOADS 128
+
+/* Wallpaper as prepared off the render thread */
+typedef struct {
+    /* Renderer capabilities, filled in before the worker starts */
+    int gpu_scale;              /* renderer can scale into a target texture */
+    int max_texture_w;          /* 0 = unlimited */
+    int max_texture_h;
+
+    void *map;                  /* validated cache file mapping */
+    size_t map_size;
+    SDL_Surface *surface;       /* decoded image at native size, or already scaled */
+    int scaled;
+    int cacheable;
+    char cache_path[600];
+    struct stat src;
+    Uint64 key;
+} BackgroundSource;
+
+/* Staged startup - a worker decodes and rasterizes, the render thread uploads */
+typedef struct {
+    pthread_t thread;
+    int started;
+    int failed;                 /* a required font is missing */
+    atomic_int lost_wake;       /* finished, but WAKE_STARTUP_DONE couldn't be queued */
+    BackgroundSource bg;
+    PendingUpload uploads[MAX_PENDING_UPLOADS];
+    int num_uploads;
+    SDL_Texture *dialog_title[NUM_MODALS];  /* composed into the dialogs, then dropped */
+    SDL_Texture *dialog_hint;
+} Startup;
+
+/* Wallpaper alone re-prepared off the render thread after a same-scale resize */
+typedef struct {
+    pthread_t thread;
+    int started;
+    atomic_int lost_wake;       /* done, but WAKE_BACKGROUND couldn't be queued */
+    int width, height;          /* size being prepared for */
+    BackgroundSource bg;
+} BackgroundRefresh;
+
+/* Font registry - each face file is mapped once and every size opens from it */
+#define MAX_FONTS 8
+
+typedef struct {
+    void *data;
+    size_t size;
+} FontFile;
+
+typedef struct {
+    FontFile sans;
+    FontFile nerd;
+    TTF_Font *open[MAX_FONTS];  /* every handle handed out, closed exactly once */
+    int num_open;
+} FontRegistry;
+
+/* Idle page-cache prefetcher for apps marked warm */
+#define WARM_DELAY_MS       5000    /* idle time before prefetching starts */
+#define WARM_SNAPSHOT_MS    20000   /* app uptime at which its mapped files are recorded */
+#define MAX_WARM_PROCS      32
+#define MAX_WARM_FILES      1024
+
+typedef struct {
+    pthread_t thread;
+    int started;
+    atomic_int stop;
+    atomic_int done;
+    SDL_TimerID timer;          /* pending WAKE_WARM */
+    SDL_TimerID snapshot_timer;
+    pid_t snapshot_pid;
+    char snapshot_path[600];    /* list file for the app being snapshotted */
+} Warmer;
+
+/* Child supervisor - turns the launched app's exit into a wake event */
+typedef struct {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    int wake_fd;            /* eventfd - new child to watch, or shutdown */
+    int sig_fd;             /* signalfd on SIGCHLD, only when pidfd_open is unavailable */
+    pid_t pid;              /* child being watched, 0 if none */
+    int pid_fd;             /* pidfd for pid, -1 on the signalfd path */
+    int running;
+} ChildSupervisor;
+
+/* Control socket - line commands from other processes, see control_execute() */
+#define MAX_CONTROL_CLIENTS 8
+#define CONTROL_LINE_MAX    256
+
+typedef struct {
+    int fd;                 /* -1 if the slot is free */
+    int len;
+    char buf[CONTROL_LINE_MAX];
+} ControlClient;
+
+/* One received line, executed and answered on the main thread */
+typedef struct {
+    int fd;                 /* dup of the client socket, closed after the reply */
+    char line[CONTROL_LINE_MAX];
+} ControlCommand;
+
+typedef struct {
+    pthread_t thread;
+    int started;
+    int listen_fd;
+    int epoll_fd;
+    int stop_fd;            /* eventfd - shutdown */
+    char path[108];         /* sizeof(sun_path) */
+    ControlClient clients[MAX_CONTROL_CLIENTS];
+} ControlServer;
+
+/* Remote input - evdev remotes read directly, see remote_thread_func() */
+#define MAX_REMOTES 4
+
+typedef struct {
+    int fd;                 /* -1 if the slot is free */
+    char node[16];          /* eventN under /dev/input */
+    int passthrough_fd;     /* uinput device re-emitting unmapped keys, -1 if none */
+} RemoteDevice;
+
+typedef struct {
+    pthread_t thread;
+    int started;
+    atomic_int stop;
+    atomic_int active;      /* launcher on screen - devices open and grabbed */
+    int epoll_fd;
+    int wake_fd;            /* eventfd - active changed, or shutdown */
+    int timer_fd;           /* next repeat of the held key */
+    int notify_fd;          /* inotify on /dev/input for hotplug, -1 without */
+    RemoteDevice devices[MAX_REMOTES];
+    int held;               /* remote_keys[] index repeating, -1 if none */
+    int repeats;            /* repeats so far, shortens the interval */
+} RemoteInput;
+
 /* Global state */
 typedef struct {
     SDL_Window *window;
     SDL_Renderer *renderer;
     int width, height;
+    float scale;                /* display scale every texture and font is rasterized at */
+    int resize_pending;         /* size changed mid-startup, applied once it completes */
+    int backend;                /* BACKEND_* in use, never BACKEND_AUTO */
+    int video_released;         /* KMSDRM video shut down so an app can be DRM master */
 
     /* Fonts */
     TTF_Font *font_clock;
@@ -105,36 +606,79 @@ typedef struct {
     TTF_Font *font_stat_label;
     TTF_Font *font_icon;
     TTF_Font *font_icon_small;
+    FontRegistry fonts;         /* owns all of the above */
 
     /* Cached textures */
+    SDL_Texture *frame;         /* persistent composited back buffer */
     SDL_Texture *background;
     SDL_Texture *tile_bg_normal;
     SDL_Texture *tile_bg_selected;
     SDL_Texture *stats_bar_bg;
+    SDL_Texture *sparklines;    /* streaming, HISTORY_LEN x NUM_STATS bands */
+    int spark_band;             /* band height in texture pixels */
     SDL_Texture *settings_bg_normal;
     SDL_Texture *settings_bg_selected;
-    SDL_Texture *tile_labels[NUM_APPS];
-    SDL_Texture *tile_icons[NUM_APPS];
-    SDL_Texture *tile_icons_dim[NUM_APPS];
-    SDL_Texture *stat_labels[4];
-    SDL_Texture *stat_icons[4];
+    SDL_Texture *settings_ring;
+    SDL_Texture *tile_border_normal;
+    SDL_Texture *tile_border_selected;
+    TileTextures tile_tex[MAX_VISIBLE_TILES];
+    SDL_Texture *stat_labels[NUM_STATS];
+    SDL_Texture *throttled_label;   /* replaces the TEMP label while throttled */
     SDL_Texture *settings_icon;
     SDL_Texture *settings_icon_dim;
     SDL_Texture *help_text;
+    SDL_Texture *dialogs[NUM_MODALS];   /* fully composed confirmation dialogs */
+    SDL_Texture *date_text;
+    int date_yday;
+
+    /* Glyph atlases for per-frame text */
+    GlyphAtlas clock_atlas;
+    GlyphAtlas value_atlas[NUM_LEVELS];
+    GlyphAtlas stat_icon_atlas[NUM_LEVELS];
 
     /* State */
+    Startup startup;
+    BackgroundRefresh bg_refresh;
+    int ready;              /* startup uploads done, scene can be drawn */
+    int failed;             /* quitting because the scene couldn't be rebuilt */
     int selected;
     int settings_selected;
-    int needs_redraw;
+    int modal;              /* MODAL_* dialog currently open */
+    Uint32 dirty;           /* REGION_BIT() mask awaiting recomposite */
     int last_minute;
     int app_running;  /* 1 if an app is in foreground */
+    int suspended;          /* scene released while the app runs, see launcher_suspend() */
+    Uint32 wake_event;      /* registered SDL_UserEvent type, (Uint32)-1 if unavailable */
+    SDL_TimerID clock_timer;
+    int idle;               /* IDLE_* screensaver state */
+    Uint32 last_input;      /* SDL_GetTicks() of the last key or command */
+    SDL_TimerID idle_timer; /* pending WAKE_IDLE */
+    time_t idle_minute;     /* minute the dimmed clock last showed - text and spot follow it */
+
+    /* Animation - only runs the loop frame-paced while a tween is active */
+    Tween sel_fade[MAX_APPS + 1];   /* selection amount per app, SEL_SETTINGS last */
+    Tween highlight_x;              /* position of the sliding tile border */
+    Tween highlight_y;
+    Uint32 anim_now;                /* time the current frame is drawn at */
+    int vsync;                      /* present blocks on VSync */
 
     /* Stats */
     Stats stats;
+    StatsHistory history;
     pthread_t stats_thread;
 
+    ChildSupervisor supervisor;
+    Warmer warmer;
+    ControlServer control;
+    RemoteInput remote;
+
     /* Layout */
-    SDL_Rect tile_rects[NUM_APPS];
+    SDL_Rect regions[NUM_REGIONS];
+    Catalog catalog;
+    SDL_Rect tile_rects[MAX_VISIBLE_TILES];     /* per on-screen slot */
+    int grid_cols;
+    int grid_rows;              /* visible rows */
+    int scroll_row;             /* catalog row shown in the top slot row */
     int stats_bar_x, stats_bar_y;
     int stats_bar_w, stats_bar_h;
 } Launcher;
@@ -143,10 +687,45 @@ static Launcher *g_launcher = NULL;
 
 /* Forward declarations */
 static void launcher_destroy(Launcher *l);
+static int startup_begin(Launcher *l);
+static void *startup_thread_func(void *arg);
+static int startup_finish(Launcher *l);
+static int launcher_resize(Launcher *l, int width, int height);
+static int get_stat_level(int value, int is_temp);
+static int rtt_level(int rtt);
 static void draw_rounded_rect(SDL_Renderer *r, SDL_Rect *rect, int radius, Uint8 cr, Uint8 cg, Uint8 cb, Uint8 ca);
 
 /* ============ Utility Functions ============ */
 
+/* $XDG_CONFIG_HOME/tvstreamer/<name>, falling back to ~/.config */
+static int config_path(char *buf, size_t size, const char *name) {
+    const char *xdg = getenv("XDG_CONFIG_HOME");
+    const char *home = getenv("HOME");
+    int n;
+
+    if (xdg && *xdg) {
+        n = snprintf(buf, size, "%s/tvstreamer/%s", xdg, name);
+    } else if (home && *home) {
+        n = snprintf(buf, size, "%s/.config/tvstreamer/%s", home, name);
+    } else {
+        return 0;
+    }
+    return n > 0 && (size_t)n < size;
+}
+
+static char *trim(char *s) {
+    while (*s == ' ' || *s == '\t') s++;
+    char *end = s + strlen(s);
+    while (end > s && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) end--;
+    *end = '\0';
+    return s;
+}
+
+/* Design pixels at the current display scale */
+static int scale_px(const Launcher *l, int v) {
+    return (int)(v * l->scale + 0.5f);
+}
+
 static SDL_Color make_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
     SDL_Color c = {r, g, b, a};
     return c;
@@ -160,18 +739,410 @@ static SDL_Texture *render_text(Launcher *l, TTF_Font *font, const char *text, S
     return tex;
 }
 
-static void blit_texture_centered(Launcher *l, SDL_Texture *tex, int cx, int cy) {
+/* Copy with a temporary alpha modulation - nothing at all when fully transparent */
+static void render_copy_alpha(Launcher *l, SDL_Texture *tex, const SDL_Rect *dst, float alpha) {
+    if (!tex || alpha <= 0.0f) return;
+    Uint8 a = alpha >= 1.0f ? 255 : (Uint8)(alpha * 255.0f + 0.5f);
+    if (a != 255) SDL_SetTextureAlphaMod(tex, a);
+    SDL_RenderCopy(l->renderer, tex, NULL, dst);
+    if (a != 255) SDL_SetTextureAlphaMod(tex, 255);
+}
+
+static void blit_texture_centered_alpha(Launcher *l, SDL_Texture *tex, int cx, int cy, float alpha) {
     if (!tex) return;
     int w, h;
     SDL_QueryTexture(tex, NULL, NULL, &w, &h);
     SDL_Rect dst = {cx - w/2, cy - h/2, w, h};
-    SDL_RenderCopy(l->renderer, tex, NULL, &dst);
+    render_copy_alpha(l, tex, &dst, alpha);
+}
+
+static void blit_texture_centered(Launcher *l, SDL_Texture *tex, int cx, int cy) {
+    blit_texture_centered_alpha(l, tex, cx, cy, 1.0f);
+}
+
+/* ============ Wake Events ============ */
+
+/* Wake the main loop from any thread - SDL_PushEvent is thread-safe. Returns 0 if not queued */
+static int post_wake(Launcher *l, int code, void *data) {
+    if (l->wake_event == (Uint32)-1) return 0;
+
+    SDL_Event e;
+    memset(&e, 0, sizeof(e));
+    e.type = l->wake_event;
+    e.user.code = code;
+    e.user.data1 = data;
+    return SDL_PushEvent(&e) > 0;
+}
+
+/* Milliseconds until the wall clock reaches the next minute */
+static Uint32 ms_until_next_minute(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (Uint32)((59 - ts.tv_sec % 60) * 1000 + (1000 - ts.tv_nsec / 1000000)) + 1;
+}
+
+/* Timer thread callback - re-arms itself for the following minute boundary */
+static Uint32 clock_timer_func(Uint32 interval, void *arg) {
+    (void)interval;
+    post_wake((Launcher *)arg, WAKE_CLOCK, NULL);
+    return ms_until_next_minute();
+}
+
+/* ============ Profiling ============ */
+
+/*
+ * --profile instrumentation. Startup phases are stamped against process
+ * start, draws keep a ring of recent CPU and present times, and wakeups are
+ * counted by source. Everything is a no-op unless enabled, and the summary
+ * goes to stderr on exit.
+ */
+enum {
+    PHASE_SDL_INIT,
+    PHASE_WINDOW,           /* window + renderer */
+    PHASE_FIRST_PIXEL,
+    PHASE_FONTS,            /* worker */
+    PHASE_CATALOG,          /* worker */
+    PHASE_BG_PREPARE,       /* worker - wallpaper decode or cache map */
+    PHASE_RASTERIZE,        /* worker */
+    PHASE_BG_UPLOAD,
+    PHASE_CACHE_SURFACES,
+    PHASE_LAYOUT,
+    PHASE_FIRST_FRAME,      /* ready until the first full present */
+    NUM_PHASES
+};
+
+static const char *const phase_names[NUM_PHASES] = {
+    "sdl init", "window", "first pixel", "fonts", "catalog", "bg prepare",
+    "rasterize", "bg upload", "cache surfaces", "layout", "first frame",
+};
+
+static const char *const wake_names[] = {
+    "stats", "child", "clock", "startup", "warm", "snapshot", "control", "idle", "background",
+};
+
+_Static_assert(sizeof(wake_names) / sizeof(*wake_names) == NUM_WAKE_CODES, "a name per WAKE_* code");
+
+#define PROFILE_SAMPLES 4096    /* recent draws kept for percentiles */
+
+typedef struct {
+    int enabled;
+    Uint64 t0;                              /* process start */
+    Uint64 phase_start[NUM_PHASES];
+    Uint64 phase_end[NUM_PHASES];
+    Uint64 ready_at;
+    Uint32 draw_cpu_us[PROFILE_SAMPLES];
+    Uint32 present_us[PROFILE_SAMPLES];
+    Uint64 draws;
+    Uint64 wakeups;                         /* returns from the blocking wait */
+    Uint64 input_events;
+    Uint64 wake_events[NUM_WAKE_CODES];
+} Profile;
+
+static Profile g_profile;
+
+static Uint64 clock_ns(clockid_t clk) {
+    struct timespec ts;
+    clock_gettime(clk, &ts);
+    return (Uint64)ts.tv_sec * 1000000000ull + (Uint64)ts.tv_nsec;
+}
+
+/* Timestamp for a later profile_elapsed - 0 and free when profiling is off */
+static Uint64 profile_now(clockid_t clk) {
+    return g_profile.enabled ? clock_ns(clk) : 0;
+}
+
+static Uint64 profile_elapsed(clockid_t clk, Uint64 since) {
+    return g_profile.enabled ? clock_ns(clk) - since : 0;
+}
+
+/* Phases are only stamped on the first startup, not again after a resume */
+static void profile_begin(int phase) {
+    if (g_profile.enabled && !g_profile.phase_end[phase]) {
+        g_profile.phase_start[phase] = clock_ns(CLOCK_MONOTONIC);
+    }
+}
+
+static void profile_end(int phase) {
+    if (g_profile.enabled && !g_profile.phase_end[phase]) {
+        g_profile.phase_end[phase] = clock_ns(CLOCK_MONOTONIC);
+    }
+}
+
+static void profile_ready(void) {
+    if (!g_profile.enabled || g_profile.ready_at) return;
+    g_profile.ready_at = clock_ns(CLOCK_MONOTONIC);
+    g_profile.phase_start[PHASE_FIRST_FRAME] = g_profile.ready_at;
+}
+
+static void profile_draw(Uint64 cpu_ns, Uint64 present_ns) {
+    if (!g_profile.enabled) return;
+    Uint32 i = (Uint32)(g_profile.draws++ % PROFILE_SAMPLES);
+    g_profile.draw_cpu_us[i] = (Uint32)(cpu_ns / 1000);
+    g_profile.present_us[i] = (Uint32)(present_ns / 1000);
+    if (g_profile.ready_at) profile_end(PHASE_FIRST_FRAME);
 }
 
+static void profile_event(Uint32 wake_event, const SDL_Event *e) {
+    if (!g_profile.enabled) return;
+    if (e->type == wake_event) {
+        if (e->user.code >= 0 && e->user.code < NUM_WAKE_CODES) g_profile.wake_events[e->user.code]++;
+    } else if (e->type == SDL_KEYDOWN) {
+        g_profile.input_events++;
+    }
+}
+
+static void profile_wakeup(void) {
+    if (g_profile.enabled) g_profile.wakeups++;
+}
+
+static int cmp_u32(const void *a, const void *b) {
+    Uint32 x = *(const Uint32 *)a, y = *(const Uint32 *)b;
+    return (x > y) - (x < y);
+}
+
+/* p50 / p95 / p99 / max of microsecond samples, in milliseconds. Sorts in place */
+static void profile_percentiles(Uint32 *v, int n, double out[4]) {
+    out[0] = out[1] = out[2] = out[3] = 0.0;
+    if (n <= 0) return;
+    qsort(v, (size_t)n, sizeof(*v), cmp_u32);
+    out[0] = v[n / 2] / 1000.0;
+    out[1] = v[(n * 95) / 100] / 1000.0;
+    out[2] = v[(n * 99) / 100] / 1000.0;
+    out[3] = v[n - 1] / 1000.0;
+}
+
+static void profile_report(void) {
+    Profile *p = &g_profile;
+    if (!p->enabled) return;
+
+    Uint64 now = clock_ns(CLOCK_MONOTONIC);
+    double elapsed = (now - p->t0) / 1e9;
+    double minutes = elapsed > 1.0 ? elapsed / 60.0 : 1.0 / 60.0;
+
+    fprintf(stderr, "\n=== Profile (%.1f s) ===\n", elapsed);
+    fprintf(stderr, "Startup, ms since process start:\n");
+    for (int i = 0; i < NUM_PHASES; i++) {
+        if (!p->phase_end[i]) continue;
+        double start = (p->phase_start[i] - p->t0) / 1e6;
+        double end = (p->phase_end[i] - p->t0) / 1e6;
+        fprintf(stderr, "  %-15s %8.1f - %8.1f  (%.1f)\n", phase_names[i], start, end, end - start);
+    }
+
+    int n = p->draws < PROFILE_SAMPLES ? (int)p->draws : PROFILE_SAMPLES;
+    double cpu[4], present[4];
+    profile_percentiles(p->draw_cpu_us, n, cpu);
+    profile_percentiles(p->present_us, n, present);
+    fprintf(stderr, "Draws: %llu (%.1f/min)\n", (unsigned long long)p->draws, p->draws / minutes);
+    fprintf(stderr, "  cpu      p50 %6.2f  p95 %6.2f  max %6.2f ms\n", cpu[0], cpu[1], cpu[3]);
+    fprintf(stderr, "  present  p50 %6.2f  p95 %6.2f  max %6.2f ms\n", present[0], present[1], present[3]);
+
+    fprintf(stderr, "Wakeups: %llu (%.1f/min)  input %llu",
+            (unsigned long long)p->wakeups, p->wakeups / minutes, (unsigned long long)p->input_events);
+    for (int i = 0; i < NUM_WAKE_CODES; i++) {
+        fprintf(stderr, ", %s %llu", wake_names[i], (unsigned long long)p->wake_events[i]);
+    }
+    fprintf(stderr, "\n");
+
+    /* All threads, so the stats sampler and workers count too */
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) == 0) {
+        double user = ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6;
+        double sys = ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1e6;
+        fprintf(stderr, "CPU: %.2f%% average (user %.2f s, sys %.2f s), max RSS %ld KB\n",
+                elapsed > 0 ? (user + sys) * 100.0 / elapsed : 0.0, user, sys, ru.ru_maxrss);
+    }
+}
+
+/* ============ Glyph Atlas ============ */
+
+static SDL_Color level_color(int level) {
+    switch (level) {
+        case LEVEL_RED:    return make_color(COL_RED);
+        case LEVEL_ORANGE: return make_color(COL_ORANGE);
+        case LEVEL_YELLOW: return make_color(COL_YELLOW);
+        default:           return make_color(COL_GREEN);
+    }
+}
+
+/* Rasterize glyph slots [first, last] into a single strip, uploaded later as one texture */
+static SDL_Surface *rasterize_glyph_atlas(GlyphAtlas *a, TTF_Font *font, SDL_Color color,
+                                          int first, int last) {
+    SDL_Surface *glyphs[NUM_GLYPHS] = {0};
+    int total_w = 0;
+
+    memset(a, 0, sizeof(*a));
+    for (int i = first; i <= last; i++) {
+        glyphs[i] = TTF_RenderUTF8_Blended(font, glyph_text[i], color);
+        if (!glyphs[i]) continue;
+        total_w += glyphs[i]->w;
+        if (glyphs[i]->h > a->height) a->height = glyphs[i]->h;
+    }
+
+    SDL_Surface *strip = NULL;
+    if (total_w > 0) {
+        strip = SDL_CreateRGBSurfaceWithFormat(0, total_w, a->height, 32, SDL_PIXELFORMAT_RGBA32);
+    }
+
+    int x = 0;
+    for (int i = first; i <= last; i++) {
+        if (!glyphs[i]) continue;
+        if (strip) {
+            /* Copy coverage as-is; blending into the transparent strip would darken edges */
+            SDL_SetSurfaceBlendMode(glyphs[i], SDL_BLENDMODE_NONE);
+            SDL_Rect cell = {x, 0, glyphs[i]->w, glyphs[i]->h};
+            SDL_BlitSurface(glyphs[i], NULL, strip, &cell);
+            a->cells[i] = cell;
+            x += glyphs[i]->w;
+        }
+        SDL_FreeSurface(glyphs[i]);
+    }
+
+    return strip;
+}
+
+static void destroy_glyph_atlas(GlyphAtlas *a) {
+    if (a->texture) SDL_DestroyTexture(a->texture);
+    a->texture = NULL;
+}
+
+static int glyph_run_width(const GlyphAtlas *a, const int *glyphs, int n) {
+    int w = 0;
+    for (int i = 0; i < n; i++) w += a->cells[glyphs[i]].w;
+    return w;
+}
+
+/* Draw a run of glyph slots with its top-left corner at (x, y) */
+static void draw_glyph_run(Launcher *l, const GlyphAtlas *a, const int *glyphs, int n, int x, int y) {
+    if (!a->texture) return;
+    for (int i = 0; i < n; i++) {
+        const SDL_Rect *cell = &a->cells[glyphs[i]];
+        SDL_Rect dst = {x, y, cell->w, cell->h};
+        SDL_RenderCopy(l->renderer, a->texture, cell, &dst);
+        x += cell->w;
+    }
+}
+
+static void draw_glyph_run_centered(Launcher *l, const GlyphAtlas *a, const int *glyphs, int n,
+                                    int cx, int cy) {
+    int w = glyph_run_width(a, glyphs, n);
+    draw_glyph_run(l, a, glyphs, n, cx - w/2, cy - a->height/2);
+}
+
+/* Convert a non-negative integer plus unit slot into glyph slots, returns count */
+static int format_value_glyphs(int value, int unit, int *out) {
+    int digits[10];
+    int nd = 0;
+
+    if (value < 0) value = 0;
+    do {
+        digits[nd++] = value % 10;
+        value /= 10;
+    } while (value > 0 && nd < 10);
+
+    int n = 0;
+    while (nd > 0) out[n++] = digits[--nd];
+    out[n++] = unit;
+    return n;
+}
+
+/* ============ Geometry Batching ============ */
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+/* Enough for a rounded rect fan at the maximum corner tessellation */
+#define GEOM_MAX_CORNER_SEGS 16
+#define GEOM_MAX_VERTS      (1 + 4 * (GEOM_MAX_CORNER_SEGS + 1))
+#define GEOM_MAX_INDICES    (3 * GEOM_MAX_VERTS)
+
+typedef struct {
+    SDL_Vertex verts[GEOM_MAX_VERTS];
+    int indices[GEOM_MAX_INDICES];
+    int num_verts;
+    int num_indices;
+} GeomBatch;
+
+static int geom_vertex(GeomBatch *g, float x, float y, SDL_Color c) {
+    SDL_Vertex *v = &g->verts[g->num_verts];
+    v->position.x = x;
+    v->position.y = y;
+    v->color = c;
+    v->tex_coord.x = 0;
+    v->tex_coord.y = 0;
+    return g->num_verts++;
+}
+
+static void geom_triangle(GeomBatch *g, int a, int b, int c) {
+    g->indices[g->num_indices++] = a;
+    g->indices[g->num_indices++] = b;
+    g->indices[g->num_indices++] = c;
+}
+
+/* One SDL_RenderGeometry call for the whole batch. Returns <0 if the renderer can't */
+static int geom_flush(SDL_Renderer *r, GeomBatch *g) {
+    int ret = SDL_RenderGeometry(r, NULL, g->verts, g->num_verts, g->indices, g->num_indices);
+    g->num_verts = 0;
+    g->num_indices = 0;
+    return ret;
+}
+
+/* Convex outline as a triangle fan around the centre - one draw call per rect */
+static int geom_rounded_rect(SDL_Renderer *r, const SDL_Rect *rect, int radius, SDL_Color c) {
+    GeomBatch g;
+    g.num_verts = 0;
+    g.num_indices = 0;
+
+    int segs = radius / 2;
+    if (segs < 4) segs = 4;
+    if (segs > GEOM_MAX_CORNER_SEGS) segs = GEOM_MAX_CORNER_SEGS;
+
+    float rad = (float)radius;
+    float x0 = rect->x, y0 = rect->y;
+    float x1 = rect->x + rect->w, y1 = rect->y + rect->h;
+    /* Corner centres clockwise from top-right, each sweeping a quarter turn */
+    const float cx[4] = {x1 - rad, x1 - rad, x0 + rad, x0 + rad};
+    const float cy[4] = {y0 + rad, y1 - rad, y1 - rad, y0 + rad};
+
+    int centre = geom_vertex(&g, (x0 + x1) / 2.0f, (y0 + y1) / 2.0f, c);
+    for (int k = 0; k < 4; k++) {
+        for (int s = 0; s <= segs; s++) {
+            float a = (float)M_PI * (k - 1 + (float)s / segs) / 2.0f;
+            geom_vertex(&g, cx[k] + rad * cosf(a), cy[k] + rad * sinf(a), c);
+        }
+    }
+    int rim = g.num_verts - 1;
+    for (int i = 1; i <= rim; i++) {
+        geom_triangle(&g, centre, i, i == rim ? 1 : i + 1);
+    }
+
+    SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+    return geom_flush(r, &g);
+}
+
+/* Vertical gradient as one quad with per-vertex colours */
+static int geom_vertical_gradient(SDL_Renderer *r, int w, int h, SDL_Color top, SDL_Color bottom) {
+    GeomBatch g;
+    g.num_verts = 0;
+    g.num_indices = 0;
+
+    int tl = geom_vertex(&g, 0, 0, top);
+    int tr = geom_vertex(&g, w, 0, top);
+    int br = geom_vertex(&g, w, h, bottom);
+    int bl = geom_vertex(&g, 0, h, bottom);
+    geom_triangle(&g, tl, tr, br);
+    geom_triangle(&g, tl, br, bl);
+    return geom_flush(r, &g);
+}
+#endif
+
 /* ============ Rounded Rectangle ============ */
 
 static void draw_rounded_rect(SDL_Renderer *r, SDL_Rect *rect, int radius,
                               Uint8 cr, Uint8 cg, Uint8 cb, Uint8 ca) {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    SDL_Color c = {cr, cg, cb, ca};
+    if (geom_rounded_rect(r, rect, radius, c) == 0) return;
+#endif
+
+    /* Scanline fallback for SDL older than 2.0.18 */
     SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
     SDL_SetRenderDrawColor(r, cr, cg, cb, ca);
 
@@ -231,547 +1202,4562 @@ static SDL_Texture *create_rounded_rect_texture(Launcher *l, int w, int h, int r
     return tex;
 }
 
-/* ============ System Stats Thread ============ */
-
-static void read_cpu_stats(long *idle, long *total) {
-    FILE *f = fopen("/proc/stat", "r");
-    if (!f) return;
+/* Anti-aliased ring centred in a size x size surface, coverage from distance to the stroke */
+static SDL_Surface *rasterize_ring(int size, float radius, float width, SDL_Color c) {
+    SDL_Surface *surf = SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surf) return NULL;
 
-    char buf[256];
-    if (fgets(buf, sizeof(buf), f)) {
-        long user, nice, sys, idle_t, iowait, irq, softirq;
-        sscanf(buf, "cpu %ld %ld %ld %ld %ld %ld %ld",
-               &user, &nice, &sys, &idle_t, &iowait, &irq, &softirq);
-        *idle = idle_t + iowait;
-        *total = user + nice + sys + idle_t + iowait + irq + softirq;
+    float centre = size / 2.0f;
+    for (int y = 0; y < size; y++) {
+        Uint32 *row = (Uint32 *)((Uint8 *)surf->pixels + y * surf->pitch);
+        for (int x = 0; x < size; x++) {
+            float dx = x + 0.5f - centre, dy = y + 0.5f - centre;
+            float cov = width / 2.0f + 0.5f - fabsf(sqrtf(dx * dx + dy * dy) - radius);
+            if (cov > 1.0f) cov = 1.0f;
+            if (cov < 0.0f) cov = 0.0f;
+            row[x] = SDL_MapRGBA(surf->format, c.r, c.g, c.b, (Uint8)(c.a * cov + 0.5f));
+        }
     }
-    fclose(f);
+    return surf;
 }
 
-static void *stats_thread_func(void *arg) {
-    Launcher *l = (Launcher *)arg;
-    long prev_idle = 0, prev_total = 0;
-
-    while (l->stats.running) {
-        int old_cpu = l->stats.cpu;
-        int old_mem = l->stats.mem;
-        int old_temp = l->stats.temp;
-        int old_disk = l->stats.disk;
-
-        /* CPU */
-        long idle = 0, total = 0;
-        read_cpu_stats(&idle, &total);
-        if (prev_total > 0) {
-            long idle_d = idle - prev_idle;
-            long total_d = total - prev_total;
-            if (total_d > 0) {
-                l->stats.cpu = 100 - (int)(100 * idle_d / total_d);
-            }
-        }
-        prev_idle = idle;
-        prev_total = total;
-
-        /* Memory */
-        struct sysinfo si;
-        if (sysinfo(&si) == 0) {
-            unsigned long total_mem = si.totalram * si.mem_unit;
-            unsigned long free_mem = si.freeram * si.mem_unit;
-            unsigned long buffers = si.bufferram * si.mem_unit;
-            /* Available = free + buffers + cached (approximate) */
-            unsigned long avail = free_mem + buffers;
-            l->stats.mem = (int)(100 * (total_mem - avail) / total_mem);
-        }
-
-        /* Temperature */
-        FILE *f = fopen("/sys/class/thermal/thermal_zone0/temp", "r");
-        if (f) {
-            int temp_milli;
-            if (fscanf(f, "%d", &temp_milli) == 1) {
-                l->stats.temp = temp_milli / 1000;
-            }
-            fclose(f);
-        }
-
-        /* Disk */
-        struct statvfs sv;
-        if (statvfs("/", &sv) == 0) {
-            unsigned long total_d = sv.f_blocks * sv.f_frsize;
-            unsigned long free_d = sv.f_bavail * sv.f_frsize;
-            l->stats.disk = (int)(100 * (total_d - free_d) / total_d);
-        }
-
-        /* Check if changed */
-        if (l->stats.cpu != old_cpu || l->stats.mem != old_mem ||
-            l->stats.temp != old_temp || l->stats.disk != old_disk) {
-            l->stats.changed = 1;
-        }
+/* Rectangular frame of the given thickness around a transparent w x h surface */
+static SDL_Surface *rasterize_border(int w, int h, int thickness, SDL_Color c) {
+    SDL_Surface *surf = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surf) return NULL;
 
-        sleep(2);
+    SDL_FillRect(surf, NULL, SDL_MapRGBA(surf->format, 0, 0, 0, 0));
+    Uint32 px = SDL_MapRGBA(surf->format, c.r, c.g, c.b, c.a);
+    SDL_Rect edges[4] = {
+        {0, 0, w, thickness},
+        {0, h - thickness, w, thickness},
+        {0, thickness, thickness, h - 2 * thickness},
+        {w - thickness, thickness, thickness, h - 2 * thickness}
+    };
+    for (int i = 0; i < 4; i++) {
+        SDL_FillRect(surf, &edges[i], px);
     }
-    return NULL;
+    return surf;
 }
 
-/* ============ Background Loading ============ */
+/* ============ System Stats Thread ============ */
 
-static SDL_Texture *load_background(Launcher *l) {
-    const char *paths[] = {
-        "/home/aleksa/wallpapers/1.png",
-        "/home/aleksa/Aleksa/Projects/TvStreamer/wallpapers/1.png",
-        NULL
-    };
+/* Re-read a pseudo file from the start into buf, NUL-terminated. Returns length or -1 */
+static int read_proc_fd(int fd, char *buf, size_t size) {
+    if (fd < 0) return -1;
+    ssize_t n = pread(fd, buf, size - 1, 0);
+    if (n < 0) return -1;
+    buf[n] = '\0';
+    return (int)n;
+}
 
-    for (int i = 0; paths[i]; i++) {
-        SDL_Surface *surf = IMG_Load(paths[i]);
-        if (surf) {
-            /* Scale to screen size */
-            SDL_Surface *scaled = SDL_CreateRGBSurfaceWithFormat(
-                0, l->width, l->height, 32, SDL_PIXELFORMAT_RGBA8888);
-            if (scaled) {
-                SDL_BlitScaled(surf, NULL, scaled, NULL);
-                SDL_FreeSurface(surf);
-                SDL_Texture *tex = SDL_CreateTextureFromSurface(l->renderer, scaled);
-                SDL_FreeSurface(scaled);
-                return tex;
-            }
-            SDL_FreeSurface(surf);
+/* read_proc_fd() for files without a size bound, growing *buf until the whole file fits */
+static int read_proc_fd_all(int fd, char **buf, size_t *size) {
+    if (fd < 0) return -1;
+    size_t len = 0;
+
+    while (1) {
+        if (len + 1 >= *size) {
+            size_t grown = *size ? *size * 2 : 8192;
+            char *p = realloc(*buf, grown);
+            if (!p) return -1;
+            *buf = p;
+            *size = grown;
         }
+        ssize_t n = pread(fd, *buf + len, *size - 1 - len, (off_t)len);
+        if (n < 0) return -1;
+        if (n == 0) break;
+        len += (size_t)n;
     }
+    (*buf)[len] = '\0';
+    return (int)len;
+}
 
-    /* Fallback: gradient */
-    SDL_Texture *tex = SDL_CreateTexture(l->renderer, SDL_PIXELFORMAT_RGBA8888,
-                                         SDL_TEXTUREACCESS_TARGET, l->width, l->height);
-    SDL_SetRenderTarget(l->renderer, tex);
+/* Parse an unsigned decimal after optional blanks, advancing *p past it */
+static unsigned long long parse_ull(const char **p) {
+    const char *c = *p;
+    unsigned long long v = 0;
 
-    for (int y = 0; y < l->height; y++) {
-        float ratio = (float)y / l->height;
-        Uint8 r = 17 + (int)((26 - 17) * ratio);
-        Uint8 g = 20 + (int)((30 - 20) * ratio);
-        Uint8 b = 34 + (int)((51 - 34) * ratio);
-        SDL_SetRenderDrawColor(l->renderer, r, g, b, 255);
-        SDL_RenderDrawLine(l->renderer, 0, y, l->width, y);
+    while (*c == ' ' || *c == '\t') c++;
+    while (*c >= '0' && *c <= '9') {
+        v = v * 10 + (unsigned long long)(*c - '0');
+        c++;
     }
+    *p = c;
+    return v;
+}
 
-    SDL_SetRenderTarget(l->renderer, NULL);
-    return tex;
+static long long parse_ll(const char **p) {
+    while (**p == ' ' || **p == '\t') (*p)++;
+    if (**p == '-') {
+        (*p)++;
+        return -(long long)parse_ull(p);
+    }
+    return (long long)parse_ull(p);
 }
 
-/* ============ Font Loading ============ */
+/* First line of a small sysfs file, newline stripped. Returns 0 if it can't be read */
+static int read_sysfs_line(const char *path, char *buf, size_t size) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return 0;
+    int len = read_proc_fd(fd, buf, size);
+    close(fd);
+    if (len <= 0) return 0;
+    buf[strcspn(buf, "\n")] = '\0';
+    return 1;
+}
 
-static TTF_Font *load_font(const char *path, int size) {
-    /* Try user-provided path first */
-    if (path) {
-        TTF_Font *f = TTF_OpenFont(path, size);
-        if (f) return f;
-    }
-
-    /* Try default paths - covers Arch, Debian, Ubuntu, Fedora */
-    const char *defaults[] = {
-        "/usr/share/fonts/TTF/DejaVuSans.ttf",
-        "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
-        "/usr/share/fonts/dejavu/DejaVuSans.ttf",
-        "/usr/share/fonts/noto/NotoSans-Regular.ttf",
-        "/usr/share/fonts/google-noto/NotoSans-Regular.ttf",
-        "/usr/share/fonts/Adwaita/AdwaitaSans-Regular.ttf",
-        "/usr/share/fonts/liberation/LiberationSans-Regular.ttf",
-        "/usr/share/fonts/TTF/LiberationSans-Regular.ttf",
-        NULL
-    };
+/* Thermal zone types and hwmon driver names that measure the CPU package or SoC */
+static const char *const cpu_sensor_names[] = {
+    "x86_pkg_temp", "coretemp", "k10temp", "zenpower",
+    "cpu-thermal", "cpu_thermal", "soc-thermal", "soc_thermal", "cpu",
+    NULL
+};
 
-    for (int i = 0; defaults[i]; i++) {
-        TTF_Font *f = TTF_OpenFont(defaults[i], size);
-        if (f) return f;
+static int cpu_sensor_name(const char *name) {
+    for (int i = 0; cpu_sensor_names[i]; i++) {
+        if (strcmp(name, cpu_sensor_names[i]) == 0) return 1;
     }
-    return NULL;
+    return 0;
 }
 
-static TTF_Font *load_nerd_font(int size) {
-    const char *paths[] = {
-        "/usr/share/fonts/TTF/JetBrainsMonoNerdFont-Regular.ttf",
-        "/usr/share/fonts/TTF/JetBrainsMonoNerdFontMono-Regular.ttf",
-        "/usr/share/fonts/TTF/JetBrainsMonoNLNerdFont-Regular.ttf",
-        "/usr/share/fonts/TTF/JetBrainsMonoNLNerdFontMono-Regular.ttf",
-        NULL
-    };
+/* Sensors found so far - CPU ones, and the rest in case there are none */
+typedef struct {
+    int cpu[MAX_SENSORS], num_cpu;
+    int other[MAX_SENSORS], num_other;
+} SensorScan;
+
+static void sensor_add(SensorScan *scan, const char *path, int is_cpu) {
+    int *fds = is_cpu ? scan->cpu : scan->other;
+    int *n = is_cpu ? &scan->num_cpu : &scan->num_other;
+    if (*n >= MAX_SENSORS) return;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) fds[(*n)++] = fd;
+}
 
-    for (int i = 0; paths[i]; i++) {
-        TTF_Font *f = TTF_OpenFont(paths[i], size);
-        if (f) return f;
+/* thermal_zoneN/temp, classified by thermal_zoneN/type */
+static void scan_thermal_zones(SensorScan *scan) {
+    DIR *dir = opendir("/sys/class/thermal");
+    if (!dir) return;
+
+    struct dirent *d;
+    while ((d = readdir(dir))) {
+        if (strncmp(d->d_name, "thermal_zone", 12) != 0) continue;
+        char path[512], type[64];
+        snprintf(path, sizeof(path), "/sys/class/thermal/%s/type", d->d_name);
+        if (!read_sysfs_line(path, type, sizeof(type))) continue;
+        snprintf(path, sizeof(path), "/sys/class/thermal/%s/temp", d->d_name);
+        sensor_add(scan, path, cpu_sensor_name(type));
     }
-    return NULL;
+    closedir(dir);
 }
 
-/* ============ Cache Creation ============ */
+/* hwmonN/tempK_input, classified by hwmonN/name */
+static void scan_hwmon(SensorScan *scan) {
+    DIR *dir = opendir("/sys/class/hwmon");
+    if (!dir) return;
+
+    struct dirent *d;
+    while ((d = readdir(dir))) {
+        if (strncmp(d->d_name, "hwmon", 5) != 0) continue;
+        char path[512], name[64];
+        snprintf(path, sizeof(path), "/sys/class/hwmon/%s/name", d->d_name);
+        if (!read_sysfs_line(path, name, sizeof(name))) continue;
+        int is_cpu = cpu_sensor_name(name);
+        for (int k = 1; k <= MAX_SENSORS; k++) {
+            snprintf(path, sizeof(path), "/sys/class/hwmon/%s/temp%d_input", d->d_name, k);
+            if (access(path, R_OK) == 0) sensor_add(scan, path, is_cpu);
+        }
+    }
+    closedir(dir);
+}
+
+/*
+ * Decide once which temperature inputs to poll: the CPU package / SoC
+ * sensors where the platform names them, every sensor otherwise. The
+ * hottest of them is reported each tick.
+ */
+static void sampler_find_sensors(ProcSampler *ps) {
+    SensorScan scan = {0};
+    scan_thermal_zones(&scan);
+    scan_hwmon(&scan);
+
+    int use_cpu = scan.num_cpu > 0;
+    int *keep = use_cpu ? scan.cpu : scan.other;
+    int *drop = use_cpu ? scan.other : scan.cpu;
+    int num_drop = use_cpu ? scan.num_other : scan.num_cpu;
+
+    ps->num_thermal = use_cpu ? scan.num_cpu : scan.num_other;
+    memcpy(ps->thermal_fd, keep, sizeof(int) * (size_t)ps->num_thermal);
+    for (int i = 0; i < num_drop; i++) {
+        close(drop[i]);
+    }
+}
+
+/* A single number from sysfs, 0 if unreadable */
+static unsigned long long read_freq(int fd) {
+    char buf[32];
+    if (read_proc_fd(fd, buf, sizeof(buf)) <= 0) return 0;
+    const char *p = buf;
+    return parse_ull(&p);
+}
+
+/* One current-clock and policy-cap reader per cpufreq policy */
+static void sampler_find_cpufreq(ProcSampler *ps) {
+    DIR *dir = opendir("/sys/devices/system/cpu/cpufreq");
+    if (!dir) return;
+
+    struct dirent *d;
+    while ((d = readdir(dir)) && ps->num_freq < MAX_FREQ_POLICIES) {
+        if (strncmp(d->d_name, "policy", 6) != 0) continue;
+        char path[512], buf[32];
+        int n = ps->num_freq;
+
+        /* The cap as configured - boost off, a user limit or a power profile sit below the hardware maximum */
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpufreq/%s/scaling_max_freq", d->d_name);
+        if (!read_sysfs_line(path, buf, sizeof(buf))) continue;
+        const char *p = buf;
+        ps->freq_base[n] = parse_ull(&p);
+        if (ps->freq_base[n] == 0) continue;
+
+        /* The cores clocked together, e.g. "0 1 2 3" */
+        char cpus[256];
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpufreq/%s/related_cpus", d->d_name);
+        ps->freq_cpus[n] = 0;
+        if (read_sysfs_line(path, cpus, sizeof(cpus))) {
+            for (p = cpus; *p; ) {
+                unsigned long long cpu = parse_ull(&p);
+                if (cpu < MAX_CPUS) ps->freq_cpus[n] |= 1u << cpu;
+                while (*p && (*p < '0' || *p > '9')) p++;
+            }
+        }
+
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpufreq/%s/scaling_max_freq", d->d_name);
+        ps->freq_cap_fd[n] = open(path, O_RDONLY | O_CLOEXEC);
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpufreq/%s/scaling_cur_freq", d->d_name);
+        ps->freq_cur_fd[n] = open(path, O_RDONLY | O_CLOEXEC);
+        if (ps->freq_cap_fd[n] < 0 || ps->freq_cur_fd[n] < 0) {
+            if (ps->freq_cap_fd[n] >= 0) close(ps->freq_cap_fd[n]);
+            if (ps->freq_cur_fd[n] >= 0) close(ps->freq_cur_fd[n]);
+            continue;
+        }
+        ps->num_freq++;
+    }
+    closedir(dir);
+}
+
+/* What the kernel itself counts as throttling: x86 throttle events and active CPU cooling devices */
+static void sampler_find_throttle(ProcSampler *ps) {
+    char path[512], type[64];
+
+    for (int cpu = 0; cpu < MAX_CPUS; cpu++) {
+        snprintf(path, sizeof(path),
+                 "/sys/devices/system/cpu/cpu%d/thermal_throttle/core_throttle_count", cpu);
+        int fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (fd >= 0) ps->throttle_fd[ps->num_throttle++] = fd;
+    }
+    if (ps->num_throttle) {
+        int fd = open("/sys/devices/system/cpu/cpu0/thermal_throttle/package_throttle_count",
+                      O_RDONLY | O_CLOEXEC);
+        if (fd >= 0) ps->throttle_fd[ps->num_throttle++] = fd;
+    }
+    for (int i = 0; i < ps->num_throttle; i++) {
+        ps->throttle_events += read_freq(ps->throttle_fd[i]);
+    }
+
+    DIR *dir = opendir("/sys/class/thermal");
+    if (!dir) return;
+    struct dirent *d;
+    while ((d = readdir(dir)) && ps->num_cooling < MAX_SENSORS) {
+        if (strncmp(d->d_name, "cooling_device", 14) != 0) continue;
+        snprintf(path, sizeof(path), "/sys/class/thermal/%s/type", d->d_name);
+        if (!read_sysfs_line(path, type, sizeof(type))) continue;
+        /* ACPI passive cooling, or the cpufreq cooling of ARM SoCs - fans don't slow anything down */
+        if (strcmp(type, "Processor") != 0 && !strstr(type, "cpufreq")) continue;
+        snprintf(path, sizeof(path), "/sys/class/thermal/%s/cur_state", d->d_name);
+        int fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (fd >= 0) ps->cooling_fd[ps->num_cooling++] = fd;
+    }
+    closedir(dir);
+}
+
+/* mounts.conf lists the mount points to watch, one per line - just "/" without it */
+static void sampler_load_mounts(ProcSampler *ps) {
+    char path[512], line[256];
+    FILE *f = config_path(path, sizeof(path), "mounts.conf") ? fopen(path, "r") : NULL;
+
+    while (f && fgets(line, sizeof(line), f) && ps->num_mounts < MAX_MOUNTS) {
+        line[strcspn(line, "\n")] = '\0';
+        char *mp = trim(line);
+        if (*mp == '\0' || *mp == '#') continue;
+        if (*mp != '/') {
+            fprintf(stderr, "Warning: %s: ignoring relative mount \"%s\"\n", path, mp);
+            continue;
+        }
+        snprintf(ps->mounts[ps->num_mounts++], sizeof(ps->mounts[0]), "%s", mp);
+    }
+    if (f) fclose(f);
+
+    if (ps->num_mounts == 0) {
+        snprintf(ps->mounts[0], sizeof(ps->mounts[0]), "/");
+        ps->num_mounts = 1;
+    }
+}
+
+/* Mount point mp contains path */
+static int mount_covers(const char *mp, const char *path) {
+    size_t n = strlen(mp);
+    if (n == 1 && mp[0] == '/') return 1;
+    return strncmp(path, mp, n) == 0 && (path[n] == '\0' || path[n] == '/');
+}
+
+/*
+ * Block device under path, from the deepest /proc/self/mountinfo entry
+ * containing it. The mount source is preferred over the listed device
+ * number, which is an anonymous 0:N on btrfs and similar.
+ */
+static int mount_device(const char *path, unsigned int *major_out, unsigned int *minor_out) {
+    FILE *f = fopen("/proc/self/mountinfo", "r");
+    if (!f) return 0;
+
+    char line[1024];
+    size_t best_len = 0;
+    int found = 0;
+
+    while (fgets(line, sizeof(line), f)) {
+        unsigned int maj = 0, min = 0;
+        char mp[256], source[256];
+        /* id parent maj:min root mount-point ... - fstype source options */
+        if (sscanf(line, "%*u %*u %u:%u %*s %255s", &maj, &min, mp) != 3) continue;
+        const char *sep = strstr(line, " - ");
+        if (!sep || sscanf(sep, " - %*s %255s", source) != 1) continue;
+
+        size_t len = strlen(mp);
+        if (!mount_covers(mp, path) || len < best_len) continue;
+
+        struct stat st;
+        if (strncmp(source, "/dev/", 5) == 0 && stat(source, &st) == 0 && S_ISBLK(st.st_mode)) {
+            maj = major(st.st_rdev);
+            min = minor(st.st_rdev);
+        }
+        best_len = len;
+        *major_out = maj;
+        *minor_out = min;
+        found = maj != 0;
+    }
+    fclose(f);
+    return found;
+}
+
+/* Re-resolve the devices behind the mounts, keeping counters for ones still there */
+static void sampler_find_devices(ProcSampler *ps) {
+    BlockDev devs[MAX_MOUNTS];
+    int n = 0;
+
+    for (int m = 0; m < ps->num_mounts; m++) {
+        unsigned int maj = 0, min = 0;
+        if (!mount_device(ps->mounts[m], &maj, &min)) continue;
+
+        int dup = 0;
+        for (int i = 0; i < n; i++) {
+            dup |= devs[i].major == maj && devs[i].minor == min;
+        }
+        if (dup) continue;
+
+        devs[n] = (BlockDev){maj, min, 0, 0, 0};
+        for (int i = 0; i < ps->num_devs; i++) {
+            if (ps->devs[i].major == maj && ps->devs[i].minor == min) devs[n] = ps->devs[i];
+        }
+        n++;
+    }
+    memcpy(ps->devs, devs, sizeof(BlockDev) * (size_t)n);
+    ps->num_devs = n;
+}
+
+/* probe.conf holds "host [port]" to measure RTT against; no file, no probe */
+static NetProbe *sampler_load_probe(void) {
+    char path[512], line[300];
+    FILE *f = config_path(path, sizeof(path), "probe.conf") ? fopen(path, "r") : NULL;
+    if (!f) return NULL;
+
+    NetProbe *np = calloc(1, sizeof(*np));
+    while (np && fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\n")] = '\0';
+        char *entry = trim(line);
+        if (*entry == '\0' || *entry == '#') continue;
+        if (sscanf(entry, "%255s %15s", np->host, np->port) < 2) snprintf(np->port, sizeof(np->port), "443");
+        break;
+    }
+    fclose(f);
+
+    if (np && !np->host[0]) {
+        free(np);
+        return NULL;
+    }
+    if (np) {
+        pthread_mutex_init(&np->lock, NULL);
+        pthread_cond_init(&np->wake, NULL);
+        np->refs = 1;
+    }
+    return np;
+}
+
+static void sampler_open(ProcSampler *ps) {
+    memset(ps, 0, sizeof(*ps));
+    ps->stat_fd = open("/proc/stat", O_RDONLY | O_CLOEXEC);
+    ps->meminfo_fd = open("/proc/meminfo", O_RDONLY | O_CLOEXEC);
+    ps->diskstats_fd = open("/proc/diskstats", O_RDONLY | O_CLOEXEC);
+    sampler_find_sensors(ps);
+    sampler_find_cpufreq(ps);
+    sampler_find_throttle(ps);
+    sampler_load_mounts(ps);
+    ps->netdev_fd = open("/proc/net/dev", O_RDONLY | O_CLOEXEC);
+    ps->probe = sampler_load_probe();
+}
+
+static int cpu_usage(CpuTimes *prev, unsigned long long idle, unsigned long long total, int old) {
+    int usage = old;
+    /* Counters can step backwards (iowait, hotplugged CPUs) - never let a delta wrap */
+    if (prev->total > 0 && total > prev->total) {
+        unsigned long long idle_d = idle > prev->idle ? idle - prev->idle : 0;
+        unsigned long long total_d = total - prev->total;
+        if (idle_d > total_d) idle_d = total_d;
+        usage = 100 - (int)(100 * idle_d / total_d);
+    }
+    prev->idle = idle;
+    prev->total = total;
+    return usage;
+}
+
+/* Aggregate and per-core usage from the leading cpu lines of /proc/stat */
+static void sample_cpu(ProcSampler *ps, StatsSample *st) {
+    char buf[8192];
+    int len = read_proc_fd(ps->stat_fd, buf, sizeof(buf));
+    if (len < 0) return;
+
+    const char *p = buf;
+    const char *end = buf + len;
+    int ncpu = 0;
+
+    while (p + 3 < end && p[0] == 'c' && p[1] == 'p' && p[2] == 'u') {
+        /* Ignore a line cut short by the buffer */
+        const char *eol = memchr(p, '\n', (size_t)(end - p));
+        if (!eol) break;
+
+        p += 3;
+        int slot = 0;
+        if (*p >= '0' && *p <= '9') {
+            slot = 1 + (int)parse_ull(&p);
+        }
+
+        unsigned long long user = parse_ull(&p);
+        unsigned long long nice = parse_ull(&p);
+        unsigned long long sys = parse_ull(&p);
+        unsigned long long idle = parse_ull(&p);
+        unsigned long long iowait = parse_ull(&p);
+        unsigned long long irq = parse_ull(&p);
+        unsigned long long softirq = parse_ull(&p);
+        unsigned long long idle_all = idle + iowait;
+        unsigned long long total = user + nice + sys + idle + iowait + irq + softirq;
+
+        if (slot == 0) {
+            st->cpu = cpu_usage(&ps->prev[0], idle_all, total, st->cpu);
+        } else if (slot <= MAX_CPUS) {
+            st->cpu_core[slot - 1] = cpu_usage(&ps->prev[slot], idle_all, total,
+                                               st->cpu_core[slot - 1]);
+            if (slot > ncpu) ncpu = slot;
+        }
+        p = eol + 1;
+    }
+    st->ncpu = ncpu;
+}
+
+static const struct {
+    const char *key;
+    size_t len;
+} meminfo_keys[NUM_MEMINFO] = {
+    [MEMINFO_TOTAL]      = {"MemTotal", 8},
+    [MEMINFO_FREE]       = {"MemFree", 7},
+    [MEMINFO_AVAILABLE]  = {"MemAvailable", 12},
+    [MEMINFO_BUFFERS]    = {"Buffers", 7},
+    [MEMINFO_CACHED]     = {"Cached", 6},
+    [MEMINFO_SWAP_TOTAL] = {"SwapTotal", 9},
+    [MEMINFO_SWAP_FREE]  = {"SwapFree", 8},
+};
+
+/*
+ * One pass over /proc/meminfo into kB[MEMINFO_*], stopping once every
+ * wanted key is seen - they all sit near the top. Missing keys read 0.
+ * Returns 0 if the file can't be read.
+ */
+static int read_meminfo(ProcSampler *ps, unsigned long long kb[NUM_MEMINFO]) {
+    char buf[4096];
+    int len = read_proc_fd(ps->meminfo_fd, buf, sizeof(buf));
+    if (len <= 0) return 0;
+
+    const char *p = buf;
+    const char *end = buf + len;
+    int found = 0;
+
+    memset(kb, 0, sizeof(kb[0]) * NUM_MEMINFO);
+    while (p < end && found < NUM_MEMINFO) {
+        const char *eol = memchr(p, '\n', (size_t)(end - p));
+        if (!eol) break;
+        const char *colon = memchr(p, ':', (size_t)(eol - p));
+
+        if (colon) {
+            size_t key_len = (size_t)(colon - p);
+            for (int k = 0; k < NUM_MEMINFO; k++) {
+                if (key_len == meminfo_keys[k].len && memcmp(p, meminfo_keys[k].key, key_len) == 0) {
+                    const char *v = colon + 1;
+                    kb[k] = parse_ull(&v);
+                    found++;
+                    break;
+                }
+            }
+        }
+        p = eol + 1;
+    }
+    return 1;
+}
+
+/* RAM from MemAvailable, which counts reclaimable page cache as free, plus swap use */
+static int sample_memory(ProcSampler *ps, StatsSample *st) {
+    unsigned long long kb[NUM_MEMINFO];
+    if (!read_meminfo(ps, kb) || kb[MEMINFO_TOTAL] == 0) return 0;
+
+    /* Pre-3.14 kernels have no MemAvailable - approximate it */
+    unsigned long long avail = kb[MEMINFO_AVAILABLE];
+    if (avail == 0) avail = kb[MEMINFO_FREE] + kb[MEMINFO_BUFFERS] + kb[MEMINFO_CACHED];
+    if (avail > kb[MEMINFO_TOTAL]) avail = kb[MEMINFO_TOTAL];
+    st->mem = (int)(100 * (kb[MEMINFO_TOTAL] - avail) / kb[MEMINFO_TOTAL]);
+
+    unsigned long long swap_total = kb[MEMINFO_SWAP_TOTAL];
+    unsigned long long swap_free = kb[MEMINFO_SWAP_FREE];
+    st->swap = swap_total > swap_free ? (int)(100 * (swap_total - swap_free) / swap_total) : 0;
+    return 1;
+}
+
+/* Hottest plausible reading among the chosen sensors, in whole degrees */
+static void sample_thermal(ProcSampler *ps, StatsSample *st) {
+    long long hottest = -1;
+    for (int i = 0; i < ps->num_thermal; i++) {
+        char buf[32];
+        if (read_proc_fd(ps->thermal_fd[i], buf, sizeof(buf)) <= 0) continue;
+        const char *p = buf;
+        long long milli = parse_ll(&p);
+        if (milli > 0 && milli < 150000 && milli > hottest) hottest = milli;
+    }
+    if (hottest >= 0) st->temp = (int)(hottest / 1000);
+}
+
+/*
+ * Throttled when a policy cap has been pulled below what it was at
+ * startup, when the kernel counted throttle events since the last tick,
+ * or a CPU cooling device is active. Only without either of those is the
+ * clock itself judged: busy yet under 90% of the startup cap. An idle CPU
+ * clocking down is the governor, not throttling. Needs this tick's CPU
+ * usage, so runs after sample_cpu().
+ */
+static void sample_throttle(ProcSampler *ps, StatsSample *st) {
+    int throttled = 0;
+
+    unsigned long long events = 0;
+    for (int i = 0; i < ps->num_throttle; i++) {
+        events += read_freq(ps->throttle_fd[i]);
+    }
+    if (events > ps->throttle_events) throttled = 1;
+    ps->throttle_events = events;
+
+    for (int i = 0; i < ps->num_cooling; i++) {
+        if (read_freq(ps->cooling_fd[i]) > 0) throttled = 1;
+    }
+    int counted = ps->num_throttle || ps->num_cooling;
+
+    for (int i = 0; i < ps->num_freq; i++) {
+        unsigned long long base = ps->freq_base[i];
+        unsigned long long cap = read_freq(ps->freq_cap_fd[i]);
+        unsigned long long cur = read_freq(ps->freq_cur_fd[i]);
+
+        /* One pegged core is enough to want the full clock - falls back to the total without related_cpus */
+        int busy = ps->freq_cpus[i] ? 0 : st->cpu;
+        for (int c = 0; c < st->ncpu; c++) {
+            if ((ps->freq_cpus[i] & (1u << c)) && st->cpu_core[c] > busy) busy = st->cpu_core[c];
+        }
+
+        if (cap && cap < base) throttled = 1;
+        if (!counted && cur && busy >= THROTTLE_BUSY && cur < base * 9 / 10) throttled = 1;
+    }
+    st->throttled = throttled;
+}
+
+/* Writer side - only ever called from the stats thread */
+static void stats_publish(StatsSeqlock *sl, const StatsSample *s) {
+    unsigned seq = atomic_load_explicit(&sl->seq, memory_order_relaxed);
+
+    atomic_store_explicit(&sl->seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    atomic_store_explicit(&sl->cpu, s->cpu, memory_order_relaxed);
+    atomic_store_explicit(&sl->mem, s->mem, memory_order_relaxed);
+    atomic_store_explicit(&sl->temp, s->temp, memory_order_relaxed);
+    atomic_store_explicit(&sl->disk, s->disk, memory_order_relaxed);
+    atomic_store_explicit(&sl->swap, s->swap, memory_order_relaxed);
+    atomic_store_explicit(&sl->throttled, s->throttled, memory_order_relaxed);
+    atomic_store_explicit(&sl->io_mbps, s->io_mbps, memory_order_relaxed);
+    atomic_store_explicit(&sl->io_util, s->io_util, memory_order_relaxed);
+    atomic_store_explicit(&sl->net_mbits, s->net_mbits, memory_order_relaxed);
+    atomic_store_explicit(&sl->net_rtt, s->net_rtt, memory_order_relaxed);
+    atomic_store_explicit(&sl->ncpu, s->ncpu, memory_order_relaxed);
+    for (int i = 0; i < s->ncpu; i++) {
+        atomic_store_explicit(&sl->cpu_core[i], s->cpu_core[i], memory_order_relaxed);
+    }
+    atomic_store_explicit(&sl->timestamp, s->timestamp, memory_order_relaxed);
+
+    atomic_store_explicit(&sl->seq, seq + 2, memory_order_release);
+}
+
+/* Reader side - lock-free, safe on the render path */
+static void stats_snapshot(StatsSeqlock *sl, StatsSample *out) {
+    for (;;) {
+        unsigned seq = atomic_load_explicit(&sl->seq, memory_order_acquire);
+        if (seq & 1) continue;
+
+        out->cpu = atomic_load_explicit(&sl->cpu, memory_order_relaxed);
+        out->mem = atomic_load_explicit(&sl->mem, memory_order_relaxed);
+        out->temp = atomic_load_explicit(&sl->temp, memory_order_relaxed);
+        out->disk = atomic_load_explicit(&sl->disk, memory_order_relaxed);
+        out->swap = atomic_load_explicit(&sl->swap, memory_order_relaxed);
+        out->throttled = atomic_load_explicit(&sl->throttled, memory_order_relaxed);
+        out->io_mbps = atomic_load_explicit(&sl->io_mbps, memory_order_relaxed);
+        out->io_util = atomic_load_explicit(&sl->io_util, memory_order_relaxed);
+        out->net_mbits = atomic_load_explicit(&sl->net_mbits, memory_order_relaxed);
+        out->net_rtt = atomic_load_explicit(&sl->net_rtt, memory_order_relaxed);
+        out->ncpu = atomic_load_explicit(&sl->ncpu, memory_order_relaxed);
+        if (out->ncpu > MAX_CPUS) out->ncpu = MAX_CPUS;
+        for (int i = 0; i < out->ncpu; i++) {
+            out->cpu_core[i] = atomic_load_explicit(&sl->cpu_core[i], memory_order_relaxed);
+        }
+        out->timestamp = atomic_load_explicit(&sl->timestamp, memory_order_relaxed);
+
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&sl->seq, memory_order_relaxed) == seq) return;
+    }
+}
+
+static void timespec_add_ms(struct timespec *ts, long ms) {
+    ts->tv_sec += ms / 1000;
+    ts->tv_nsec += (ms % 1000) * 1000000L;
+    if (ts->tv_nsec >= 1000000000L) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+static int timespec_before(const struct timespec *a, const struct timespec *b) {
+    return a->tv_sec < b->tv_sec || (a->tv_sec == b->tv_sec && a->tv_nsec < b->tv_nsec);
+}
+
+/*
+ * Block until the next sample is due. Paused means no timeout at all;
+ * otherwise the interval shortens while a recent input boost is active.
+ * Called and returns with the lock held. Returns 0 once stopped.
+ */
+static int stats_wait(Stats *st, const struct timespec *last_sample) {
+    while (st->running && !st->kick) {
+        if (st->paused) {
+            pthread_cond_wait(&st->wake, &st->lock);
+            continue;
+        }
+
+        struct timespec now, deadline = *last_sample;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        timespec_add_ms(&deadline, timespec_before(&now, &st->boost_until)
+                                   ? STATS_FAST_INTERVAL_MS : STATS_INTERVAL_MS);
+        if (!timespec_before(&now, &deadline)) break;
+
+        /* Woken early by boost/pause changes - loop re-evaluates the deadline */
+        if (pthread_cond_timedwait(&st->wake, &st->lock, &deadline) == ETIMEDOUT) break;
+    }
+    st->kick = 0;
+    return st->running;
+}
+
+static long timespec_diff_ms(const struct timespec *a, const struct timespec *b) {
+    return (long)(a->tv_sec - b->tv_sec) * 1000 + (a->tv_nsec - b->tv_nsec) / 1000000;
+}
+
+/* Fullest watched mount, and the devices behind them - on the slow cadence only */
+static void sample_disk(ProcSampler *ps, StatsSample *st, const struct timespec *now) {
+    if (ps->disk_due.tv_sec && timespec_before(now, &ps->disk_due)) return;
+    ps->disk_due = *now;
+    timespec_add_ms(&ps->disk_due, DISK_INTERVAL_MS);
+
+    int fullest = 0;
+    for (int m = 0; m < ps->num_mounts; m++) {
+        struct statvfs sv;
+        if (statvfs(ps->mounts[m], &sv) != 0 || sv.f_blocks == 0) continue;
+        unsigned long long total_d = (unsigned long long)sv.f_blocks * sv.f_frsize;
+        unsigned long long free_d = (unsigned long long)sv.f_bavail * sv.f_frsize;
+        int used = (int)(100 * (total_d - free_d) / total_d);
+        if (used > fullest) fullest = used;
+    }
+    st->disk = fullest;
+
+    /* Picks up a drive mounted since the last refresh */
+    sampler_find_devices(ps);
+}
+
+/* Throughput and utilization from /proc/diskstats deltas, like the CPU reader */
+static void sample_io(ProcSampler *ps, StatsSample *st, const struct timespec *now) {
+    long elapsed = timespec_diff_ms(now, &ps->io_last);
+    if (ps->io_last.tv_sec && elapsed < 1) return;
+    int len = read_proc_fd_all(ps->diskstats_fd, &ps->diskstats_buf, &ps->diskstats_size);
+    if (len < 0) return;
+
+    const char *p = ps->diskstats_buf;
+    const char *end = p + len;
+    unsigned long long bytes = 0;
+    int util = 0, counted = 0;
+
+    while (p < end) {
+        const char *eol = memchr(p, '\n', (size_t)(end - p));
+        if (!eol) break;
+
+        /* major minor name reads merged sectors ms writes merged sectors ms in-flight io_ticks */
+        unsigned int maj = (unsigned int)parse_ull(&p);
+        unsigned int min = (unsigned int)parse_ull(&p);
+        for (int i = 0; i < ps->num_devs; i++) {
+            BlockDev *d = &ps->devs[i];
+            if (d->major != maj || d->minor != min) continue;
+
+            while (*p == ' ') p++;
+            while (p < eol && *p != ' ') p++;       /* device name */
+            unsigned long long f[10];
+            for (int k = 0; k < 10; k++) f[k] = parse_ull(&p);
+            unsigned long long sectors = f[2] + f[6];
+            unsigned long long io_ticks = f[9];
+
+            if (d->seen && ps->io_last.tv_sec && sectors >= d->sectors && io_ticks >= d->io_ticks) {
+                bytes += (sectors - d->sectors) * 512;
+                int busy = (int)((io_ticks - d->io_ticks) * 100 / (unsigned long long)elapsed);
+                if (busy > util) util = busy;
+                counted = 1;
+            }
+            d->sectors = sectors;
+            d->io_ticks = io_ticks;
+            d->seen = 1;
+            break;
+        }
+        p = eol + 1;
+    }
+
+    if (counted) {
+        st->io_mbps = (int)(bytes * 1000 / (unsigned long long)elapsed / 1000000);
+        st->io_util = util > 100 ? 100 : util;
+    }
+    ps->io_last = *now;
+}
+
+/* Interfaces whose traffic is only counted again on a physical one */
+static int virtual_netdev(const char *name, size_t len) {
+    static const char *const prefixes[] = {"lo", "docker", "veth", "br-", "virbr", NULL};
+    for (int i = 0; prefixes[i]; i++) {
+        size_t n = strlen(prefixes[i]);
+        if (len >= n && memcmp(name, prefixes[i], n) == 0) return 1;
+    }
+    return 0;
+}
+
+/* RX + TX rate from /proc/net/dev byte counter deltas */
+static void sample_net(ProcSampler *ps, StatsSample *st, const struct timespec *now) {
+    char buf[8192];
+    long elapsed = timespec_diff_ms(now, &ps->net_last);
+    if (ps->net_bytes && elapsed < 1) return;
+    int len = read_proc_fd(ps->netdev_fd, buf, sizeof(buf));
+    if (len < 0) return;
+
+    const char *p = buf;
+    const char *end = buf + len;
+    unsigned long long total = 0;
+
+    while (p < end) {
+        const char *eol = memchr(p, '\n', (size_t)(end - p));
+        if (!eol) break;
+        const char *colon = memchr(p, ':', (size_t)(eol - p));
+
+        /* "  name: rx_bytes packets errs drop fifo frame compressed multicast tx_bytes ..." */
+        if (colon) {
+            while (*p == ' ') p++;
+            if (!virtual_netdev(p, (size_t)(colon - p))) {
+                const char *v = colon + 1;
+                unsigned long long f[9];
+                for (int k = 0; k < 9; k++) f[k] = parse_ull(&v);
+                total += f[0] + f[8];
+            }
+        }
+        p = eol + 1;
+    }
+
+    /* Counters restart when an interface goes away */
+    if (ps->net_bytes && total >= ps->net_bytes) {
+        st->net_mbits = (int)((total - ps->net_bytes) * 8 * 1000 / (unsigned long long)elapsed / 1000000);
+    }
+    ps->net_bytes = total ? total : 1;
+    ps->net_last = *now;
+}
+
+/* Milliseconds to a TCP handshake with addr, or -1 within timeout_ms */
+static int probe_connect(const struct addrinfo *ai, int timeout_ms) {
+    int fd = socket(ai->ai_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    int err = connect(fd, ai->ai_addr, ai->ai_addrlen) == 0 ? 0 : errno;
+    if (err == EINPROGRESS) {
+        struct pollfd pfd = {fd, POLLOUT, 0};
+        socklen_t len = sizeof(err);
+        if (poll(&pfd, 1, timeout_ms) == 1) {
+            getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len);
+        } else {
+            err = ETIMEDOUT;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    close(fd);
+
+    /* A refused connection still took a round trip, so it counts */
+    if (err != 0 && err != ECONNREFUSED) return -1;
+    long ms = timespec_diff_ms(&t1, &t0);
+    return ms < 1 ? 1 : (int)ms;
+}
+
+/*
+ * First address of the host that answers, in getaddrinfo's order - a
+ * dual-stack host whose IPv6 route is down still answers over IPv4.
+ * Resolved once, and again after every address has failed. The whole
+ * probe gives up after PROBE_BUDGET_MS, however many addresses are left.
+ */
+static int probe_rtt(NetProbe *np) {
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (!np->addrs) {
+        struct addrinfo hints = {0};
+        hints.ai_socktype = SOCK_STREAM;
+        if (getaddrinfo(np->host, np->port, &hints, &np->addrs) != 0) np->addrs = NULL;
+        if (!np->addrs) return -1;
+    }
+
+    for (const struct addrinfo *ai = np->addrs; ai; ai = ai->ai_next) {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        long left = PROBE_BUDGET_MS - timespec_diff_ms(&now, &start);
+        if (left <= 0) return -1;
+        int ms = probe_connect(ai, left < PROBE_TIMEOUT_MS ? (int)left : PROBE_TIMEOUT_MS);
+        if (ms > 0) return ms;
+    }
+    freeaddrinfo(np->addrs);
+    np->addrs = NULL;
+    return -1;
+}
+
+static void probe_release(NetProbe *np) {
+    pthread_mutex_lock(&np->lock);
+    int refs = --np->refs;
+    pthread_mutex_unlock(&np->lock);
+    if (refs) return;
+
+    if (np->addrs) freeaddrinfo(np->addrs);
+    pthread_cond_destroy(&np->wake);
+    pthread_mutex_destroy(&np->lock);
+    free(np);
+}
+
+/* One probe per request from the stats thread, so it pauses along with the stats */
+static void *probe_thread_func(void *arg) {
+    NetProbe *np = (NetProbe *)arg;
+
+    pthread_mutex_lock(&np->lock);
+    while (!np->stop) {
+        if (!np->pending) {
+            pthread_cond_wait(&np->wake, &np->lock);
+            continue;
+        }
+        np->pending = 0;
+        pthread_mutex_unlock(&np->lock);
+        atomic_store(&np->rtt, probe_rtt(np));
+        pthread_mutex_lock(&np->lock);
+    }
+    pthread_mutex_unlock(&np->lock);
+
+    probe_release(np);
+    return NULL;
+}
+
+/* The latest result - never waits on the probe itself */
+static void sample_probe(ProcSampler *ps, StatsSample *st, const struct timespec *now) {
+    NetProbe *np = ps->probe;
+    if (!np) return;
+    st->net_rtt = atomic_load(&np->rtt);
+    if (np->due.tv_sec && timespec_before(now, &np->due)) return;
+    np->due = *now;
+    timespec_add_ms(&np->due, PROBE_INTERVAL_MS);
+
+    pthread_mutex_lock(&np->lock);
+    if (!np->started) {
+        np->refs++;
+        np->started = pthread_create(&np->thread, NULL, probe_thread_func, np) == 0;
+        if (np->started) {
+            pthread_detach(np->thread);
+        } else {
+            np->refs--;
+        }
+    }
+    np->pending = 1;
+    pthread_cond_signal(&np->wake);
+    pthread_mutex_unlock(&np->lock);
+}
+
+/* Hand the probe to its thread to free - it may be stuck in a lookup */
+static void probe_stop(NetProbe *np) {
+    pthread_mutex_lock(&np->lock);
+    np->stop = 1;
+    pthread_cond_signal(&np->wake);
+    pthread_mutex_unlock(&np->lock);
+    probe_release(np);
+}
+
+static void sampler_close(ProcSampler *ps) {
+    if (ps->stat_fd >= 0) close(ps->stat_fd);
+    if (ps->meminfo_fd >= 0) close(ps->meminfo_fd);
+    if (ps->diskstats_fd >= 0) close(ps->diskstats_fd);
+    free(ps->diskstats_buf);
+    if (ps->netdev_fd >= 0) close(ps->netdev_fd);
+    for (int i = 0; i < ps->num_thermal; i++) {
+        close(ps->thermal_fd[i]);
+    }
+    for (int i = 0; i < ps->num_freq; i++) {
+        close(ps->freq_cur_fd[i]);
+        close(ps->freq_cap_fd[i]);
+    }
+    for (int i = 0; i < ps->num_throttle; i++) {
+        close(ps->throttle_fd[i]);
+    }
+    for (int i = 0; i < ps->num_cooling; i++) {
+        close(ps->cooling_fd[i]);
+    }
+    if (ps->probe) probe_stop(ps->probe);
+}
+
+/* One reading of every stat into cur - CPU usage is relative to the previous call */
+static void stats_sample(ProcSampler *ps, StatsSample *cur) {
+    /* CPU */
+    sample_cpu(ps, cur);
+
+    /* Memory - sysinfo() only when /proc/meminfo is unreadable, it ignores the page cache */
+    struct sysinfo si;
+    if (!sample_memory(ps, cur) && sysinfo(&si) == 0) {
+        unsigned long total_mem = si.totalram * si.mem_unit;
+        unsigned long free_mem = si.freeram * si.mem_unit;
+        unsigned long buffers = si.bufferram * si.mem_unit;
+        /* Available = free + buffers + cached (approximate) */
+        unsigned long avail = free_mem + buffers;
+        cur->mem = (int)(100 * (total_mem - avail) / total_mem);
+    }
+
+    /* Temperature and clock */
+    sample_thermal(ps, cur);
+    sample_throttle(ps, cur);
+
+    /* Disk fullness and I/O */
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    sample_disk(ps, cur, &now);
+    sample_io(ps, cur, &now);
+
+    /* Network */
+    sample_net(ps, cur, &now);
+    sample_probe(ps, cur, &now);
+}
+
+/* Same text and colours in the stats bar - I/O load and RTT only show as a level */
+static int stats_same_display(const StatsSample *a, const StatsSample *b) {
+    return a->cpu == b->cpu && a->mem == b->mem && a->temp == b->temp && a->disk == b->disk &&
+           a->swap == b->swap && a->throttled == b->throttled && a->io_mbps == b->io_mbps &&
+           a->net_mbits == b->net_mbits &&
+           get_stat_level(a->io_util, 0) == get_stat_level(b->io_util, 0) &&
+           rtt_level(a->net_rtt) == rtt_level(b->net_rtt);
+}
+
+static void *stats_thread_func(void *arg) {
+    Launcher *l = (Launcher *)arg;
+    ProcSampler ps;
+    StatsSample cur, shown;
+    struct timespec last_sample;
+    Uint64 column_due = 0;
+
+    sampler_open(&ps);
+    memset(&cur, 0, sizeof(cur));
+    memset(&shown, 0, sizeof(shown));
+
+    pthread_mutex_lock(&l->stats.lock);
+    while (l->stats.running) {
+        pthread_mutex_unlock(&l->stats.lock);
+        clock_gettime(CLOCK_MONOTONIC, &last_sample);
+
+        stats_sample(&ps, &cur);
+
+        cur.timestamp = (Uint64)last_sample.tv_sec * 1000 + (Uint64)(last_sample.tv_nsec / 1000000);
+
+        /* Boosted samples fall in between columns - the slack absorbs timer jitter */
+        int column = cur.timestamp >= column_due;
+        if (column) {
+            cur.columns++;
+            column_due = cur.timestamp + HISTORY_INTERVAL_MS - STATS_FAST_INTERVAL_MS / 2;
+        }
+        stats_publish(&l->stats.published, &cur);
+
+        /* Only a new sparkline column or a reading that looks different is worth a repaint */
+        if ((column || !stats_same_display(&shown, &cur)) && post_wake(l, WAKE_STATS, NULL)) {
+            shown = cur;
+        }
+
+        pthread_mutex_lock(&l->stats.lock);
+        if (!stats_wait(&l->stats, &last_sample)) break;
+    }
+    pthread_mutex_unlock(&l->stats.lock);
+
+    sampler_close(&ps);
+    return NULL;
+}
+
+static int stats_start(Launcher *l) {
+    Stats *st = &l->stats;
+    pthread_condattr_t attr;
+
+    pthread_mutex_init(&st->lock, NULL);
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&st->wake, &attr);
+    pthread_condattr_destroy(&attr);
+
+    st->running = 1;
+    if (pthread_create(&l->stats_thread, NULL, stats_thread_func, l) != 0) {
+        st->running = 0;
+        pthread_cond_destroy(&st->wake);
+        pthread_mutex_destroy(&st->lock);
+        return 0;
+    }
+    return 1;
+}
+
+static void stats_stop(Launcher *l) {
+    Stats *st = &l->stats;
+    if (!st->running) return;
+
+    pthread_mutex_lock(&st->lock);
+    st->running = 0;
+    pthread_cond_signal(&st->wake);
+    pthread_mutex_unlock(&st->lock);
+    pthread_join(l->stats_thread, NULL);
+
+    pthread_cond_destroy(&st->wake);
+    pthread_mutex_destroy(&st->lock);
+}
+
+/* Stop sampling while hidden; resuming takes a sample right away */
+static void stats_set_paused(Launcher *l, int paused) {
+    Stats *st = &l->stats;
+    if (!st->running) return;
+
+    pthread_mutex_lock(&st->lock);
+    st->paused = paused;
+    if (!paused) st->kick = 1;
+    pthread_cond_signal(&st->wake);
+    pthread_mutex_unlock(&st->lock);
+}
+
+/* Sample at the fast cadence for a few seconds after user input */
+static void stats_boost(Launcher *l) {
+    Stats *st = &l->stats;
+    if (!st->running) return;
+
+    struct timespec until;
+    clock_gettime(CLOCK_MONOTONIC, &until);
+    timespec_add_ms(&until, STATS_BOOST_MS);
+
+    pthread_mutex_lock(&st->lock);
+    st->boost_until = until;
+    pthread_cond_signal(&st->wake);
+    pthread_mutex_unlock(&st->lock);
+}
+
+/* ============ Background Cache ============ */
+
+/*
+ * The scaled wallpaper is cached as raw pixels behind a small header, so
+ * later boots mmap it and upload it with no PNG decode and no scaling.
+ * The file name is keyed by source path, mtime, size and target resolution;
+ * the header repeats the key so a stale or colliding file is rejected.
+ */
+#define BG_CACHE_MAGIC      0x47425654u     /* "TVBG" */
+#define BG_CACHE_VERSION    1
+
+typedef struct {
+    Uint32 magic;
+    Uint32 version;
+    Uint32 width;
+    Uint32 height;
+    Uint32 pitch;
+    Uint32 format;
+    Sint64 src_mtime_sec;
+    Sint64 src_mtime_nsec;
+    Sint64 src_size;
+    Uint64 key;
+    Uint32 reserved[2];             /* keeps pixel data 64-byte aligned */
+} BgCacheHeader;
+
+static Uint64 fnv1a(Uint64 h, const void *data, size_t len) {
+    const unsigned char *p = data;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static Uint64 bg_cache_key(const char *src, const struct stat *st, int w, int h) {
+    Sint64 fields[5] = {st->st_mtim.tv_sec, st->st_mtim.tv_nsec, st->st_size, w, h};
+    Uint64 key = fnv1a(0xcbf29ce484222325ULL, src, strlen(src));
+    return fnv1a(key, fields, sizeof(fields));
+}
+
+/* $XDG_CACHE_HOME/tvstreamer, created on demand. Returns 0 if unavailable */
+static int cache_dir(char *buf, size_t size) {
+    const char *xdg = getenv("XDG_CACHE_HOME");
+    const char *home = getenv("HOME");
+    int n;
+
+    if (xdg && *xdg) {
+        n = snprintf(buf, size, "%s", xdg);
+    } else if (home && *home) {
+        n = snprintf(buf, size, "%s/.cache", home);
+    } else {
+        return 0;
+    }
+    if (n < 0 || (size_t)n >= size) return 0;
+    mkdir(buf, 0755);
+
+    if (strlen(buf) + sizeof("/tvstreamer") > size) return 0;
+    strcat(buf, "/tvstreamer");
+    if (mkdir(buf, 0755) < 0 && errno != EEXIST) return 0;
+    return 1;
+}
+
+static int bg_cache_path(char *buf, size_t size, Uint64 key) {
+    char dir[512];
+    if (!cache_dir(dir, sizeof(dir))) return 0;
+    int n = snprintf(buf, size, "%s/bg-%016llx.raw", dir, (unsigned long long)key);
+    return n > 0 && (size_t)n < size;
+}
+
+static int bg_cache_valid(const BgCacheHeader *hdr, size_t file_size, const struct stat *src,
+                          Uint64 key, int w, int h) {
+    return hdr->magic == BG_CACHE_MAGIC &&
+           hdr->version == BG_CACHE_VERSION &&
+           hdr->key == key &&
+           hdr->width == (Uint32)w && hdr->height == (Uint32)h &&
+           hdr->format == SDL_PIXELFORMAT_RGBA8888 &&
+           hdr->pitch >= (Uint32)w * 4 &&
+           hdr->src_mtime_sec == src->st_mtim.tv_sec &&
+           hdr->src_mtime_nsec == src->st_mtim.tv_nsec &&
+           hdr->src_size == src->st_size &&
+           file_size >= sizeof(*hdr) + (size_t)hdr->pitch * hdr->height;
+}
+
+/* Map a cache file if it matches the wallpaper and resolution. Returns 0 on miss */
+static int bg_cache_map(BackgroundSource *bg, int w, int h) {
+    int fd = open(bg->cache_path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return 0;
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(BgCacheHeader)) {
+        close(fd);
+        return 0;
+    }
+
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return 0;
+
+    if (!bg_cache_valid(map, (size_t)st.st_size, &bg->src, bg->key, w, h)) {
+        munmap(map, (size_t)st.st_size);
+        return 0;
+    }
+
+    bg->map = map;
+    bg->map_size = (size_t)st.st_size;
+    return 1;
+}
+
+/* Upload a mapped cache file straight into a streaming texture */
+static SDL_Texture *bg_cache_upload(Launcher *l, const void *map) {
+    const BgCacheHeader *hdr = map;
+    SDL_Texture *tex = SDL_CreateTexture(l->renderer, SDL_PIXELFORMAT_RGBA8888,
+                                         SDL_TEXTUREACCESS_STREAMING, (int)hdr->width, (int)hdr->height);
+    if (!tex) return NULL;
+
+    const Uint8 *pixels = (const Uint8 *)map + sizeof(*hdr);
+    if (SDL_UpdateTexture(tex, NULL, pixels, (int)hdr->pitch) < 0) {
+        SDL_DestroyTexture(tex);
+        return NULL;
+    }
+    /* Match what SDL_CreateTextureFromSurface gives the uncached path */
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+    return tex;
+}
+
+/* Drop cached backgrounds for older wallpapers or resolutions - each is a full frame */
+static void bg_cache_prune(const char *keep) {
+    char dir[512];
+    if (!cache_dir(dir, sizeof(dir))) return;
+
+    DIR *d = opendir(dir);
+    if (!d) return;
+
+    const char *keep_name = strrchr(keep, '/');
+    keep_name = keep_name ? keep_name + 1 : keep;
+
+    struct dirent *ent;
+    while ((ent = readdir(d)) != NULL) {
+        size_t len = strlen(ent->d_name);
+        if (strncmp(ent->d_name, "bg-", 3) != 0 || len < 4 ||
+            strcmp(ent->d_name + len - 4, ".raw") != 0 ||
+            strcmp(ent->d_name, keep_name) == 0) {
+            continue;
+        }
+        unlinkat(dirfd(d), ent->d_name, 0);
+    }
+    closedir(d);
+}
+
+/* Streams a cache file to a temp name, renamed into place once complete */
+typedef struct {
+    int fd;
+    int ok;
+    const char *path;
+    char tmp[600];
+} BgCacheWriter;
+
+static int bg_cache_begin(BgCacheWriter *w, const char *path, const struct stat *src, Uint64 key,
+                          int width, int height, int pitch) {
+    int n = snprintf(w->tmp, sizeof(w->tmp), "%s.%d.tmp", path, (int)getpid());
+    if (n < 0 || (size_t)n >= sizeof(w->tmp)) return 0;
+
+    w->path = path;
+    w->fd = open(w->tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (w->fd < 0) return 0;
+
+    BgCacheHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = BG_CACHE_MAGIC;
+    hdr.version = BG_CACHE_VERSION;
+    hdr.width = (Uint32)width;
+    hdr.height = (Uint32)height;
+    hdr.pitch = (Uint32)pitch;
+    hdr.format = SDL_PIXELFORMAT_RGBA8888;
+    hdr.src_mtime_sec = src->st_mtim.tv_sec;
+    hdr.src_mtime_nsec = src->st_mtim.tv_nsec;
+    hdr.src_size = src->st_size;
+    hdr.key = key;
+
+    w->ok = write(w->fd, &hdr, sizeof(hdr)) == (ssize_t)sizeof(hdr);
+    return 1;
+}
+
+static void bg_cache_write(BgCacheWriter *w, const void *data, size_t len) {
+    if (w->ok) w->ok = write(w->fd, data, len) == (ssize_t)len;
+}
+
+static void bg_cache_finish(BgCacheWriter *w) {
+    int ok = close(w->fd) == 0 && w->ok;
+    if (!ok || rename(w->tmp, w->path) < 0) {
+        unlink(w->tmp);
+        return;
+    }
+    bg_cache_prune(w->path);
+}
+
+/* Cache a CPU-scaled surface */
+static void bg_cache_store(const char *path, const struct stat *src, Uint64 key, SDL_Surface *scaled) {
+    BgCacheWriter w;
+    if (scaled->format->format != SDL_PIXELFORMAT_RGBA8888) return;
+    if (!bg_cache_begin(&w, path, src, key, scaled->w, scaled->h, scaled->pitch)) return;
+
+    bg_cache_write(&w, scaled->pixels, (size_t)scaled->pitch * (size_t)scaled->h);
+    bg_cache_finish(&w);
+}
+
+/* Cache a GPU-scaled target texture, read back in bands to keep the buffer small */
+static void bg_cache_store_texture(Launcher *l, SDL_Texture *tex, const char *path,
+                                   const struct stat *src, Uint64 key) {
+    enum { BAND_ROWS = 64 };
+    int pitch = l->width * 4;
+    BgCacheWriter w;
+
+    Uint8 *band = malloc((size_t)pitch * BAND_ROWS);
+    if (!band) return;
+    if (!bg_cache_begin(&w, path, src, key, l->width, l->height, pitch)) {
+        free(band);
+        return;
+    }
+
+    SDL_SetRenderTarget(l->renderer, tex);
+    for (int y = 0; y < l->height && w.ok; y += BAND_ROWS) {
+        int rows = l->height - y < BAND_ROWS ? l->height - y : BAND_ROWS;
+        SDL_Rect r = {0, y, l->width, rows};
+        if (SDL_RenderReadPixels(l->renderer, &r, SDL_PIXELFORMAT_RGBA8888, band, pitch) < 0) {
+            w.ok = 0;
+            break;
+        }
+        bg_cache_write(&w, band, (size_t)pitch * (size_t)rows);
+    }
+    SDL_SetRenderTarget(l->renderer, NULL);
+
+    bg_cache_finish(&w);
+    free(band);
+}
+
+/* ============ Background Loading ============ */
+
+/* Scale on the CPU into a screen-sized surface. Consumes surf */
+static SDL_Surface *scale_background_cpu(SDL_Surface *surf, int w, int h) {
+    SDL_Surface *scaled = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_RGBA8888);
+    if (scaled) SDL_BlitScaled(surf, NULL, scaled, NULL);
+    SDL_FreeSurface(surf);
+    return scaled;
+}
+
+/*
+ * Runs on the startup worker: find the wallpaper and get it as far as it
+ * can go without the renderer - a mapped cache file, a decoded image for
+ * the GPU to scale, or a CPU-scaled surface when the GPU can't scale it.
+ */
+static void bg_prepare(BackgroundSource *bg, int width, int height) {
+    const char *paths[] = {
+        "/home/aleksa/wallpapers/1.png",
+        "/home/aleksa/Aleksa/Projects/TvStreamer/wallpapers/1.png",
+        NULL
+    };
+
+    for (int i = 0; paths[i]; i++) {
+        if (stat(paths[i], &bg->src) < 0) continue;
+
+        /* Cached copy already at screen resolution? */
+        bg->key = bg_cache_key(paths[i], &bg->src, width, height);
+        bg->cacheable = bg_cache_path(bg->cache_path, sizeof(bg->cache_path), bg->key);
+        if (bg->cacheable && bg_cache_map(bg, width, height)) return;
+
+        SDL_Surface *surf = IMG_Load(paths[i]);
+        if (!surf) continue;
+
+        int fits = (!bg->max_texture_w || surf->w <= bg->max_texture_w) &&
+                   (!bg->max_texture_h || surf->h <= bg->max_texture_h);
+        if (bg->gpu_scale && fits) {
+            bg->surface = surf;
+            return;
+        }
+
+        /* CPU fallback - scale to screen size */
+        bg->surface = scale_background_cpu(surf, width, height);
+        if (bg->surface) {
+            bg->scaled = 1;
+            if (bg->cacheable) bg_cache_store(bg->cache_path, &bg->src, bg->key, bg->surface);
+            return;
+        }
+    }
+}
+
+/*
+ * Upload the decoded image once at native size and let the renderer scale
+ * it into a screen-sized target. The decoded surface is freed as soon as it
+ * is on the GPU, so no CPU-side scaled copy ever coexists with it.
+ * Returns NULL without touching *surfp if the upload fails;
+ * *surfp is NULL afterwards once ownership was taken.
+ */
+static SDL_Texture *scale_background_gpu(Launcher *l, SDL_Surface **surfp) {
+#if !SDL_VERSION_ATLEAST(2, 0, 12)
+    /* Copied - setting the hint frees the string SDL_GetHint() returned */
+    char quality[32] = "";
+    const char *prev = SDL_GetHint(SDL_HINT_RENDER_SCALE_QUALITY);
+    if (prev) snprintf(quality, sizeof(quality), "%s", prev);
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
+#endif
+    SDL_Texture *native = SDL_CreateTextureFromSurface(l->renderer, *surfp);
+#if !SDL_VERSION_ATLEAST(2, 0, 12)
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, prev ? quality : NULL);
+#endif
+    if (!native) return NULL;
+
+    SDL_FreeSurface(*surfp);
+    *surfp = NULL;
+
+#if SDL_VERSION_ATLEAST(2, 0, 12)
+    SDL_SetTextureScaleMode(native, SDL_ScaleModeLinear);
+#endif
+    SDL_SetTextureBlendMode(native, SDL_BLENDMODE_NONE);
+
+    SDL_Texture *tex = SDL_CreateTexture(l->renderer, SDL_PIXELFORMAT_RGBA8888,
+                                         SDL_TEXTUREACCESS_TARGET, l->width, l->height);
+    if (tex) {
+        SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+        SDL_SetRenderTarget(l->renderer, tex);
+        SDL_RenderCopy(l->renderer, native, NULL, NULL);
+        SDL_SetRenderTarget(l->renderer, NULL);
+    }
+
+    SDL_DestroyTexture(native);
+    return tex;
+}
+
+static SDL_Texture *create_gradient_background(Launcher *l) {
+    SDL_Texture *tex = SDL_CreateTexture(l->renderer, SDL_PIXELFORMAT_RGBA8888,
+                                         SDL_TEXTUREACCESS_TARGET, l->width, l->height);
+    SDL_SetRenderTarget(l->renderer, tex);
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    SDL_Color top = {17, 20, 34, 255};
+    SDL_Color bottom = {26, 30, 51, 255};
+    if (geom_vertical_gradient(l->renderer, l->width, l->height, top, bottom) == 0) {
+        SDL_SetRenderTarget(l->renderer, NULL);
+        return tex;
+    }
+#endif
+
+    for (int y = 0; y < l->height; y++) {
+        float ratio = (float)y / l->height;
+        Uint8 r = 17 + (int)((26 - 17) * ratio);
+        Uint8 g = 20 + (int)((30 - 20) * ratio);
+        Uint8 b = 34 + (int)((51 - 34) * ratio);
+        SDL_SetRenderDrawColor(l->renderer, r, g, b, 255);
+        SDL_RenderDrawLine(l->renderer, 0, y, l->width, y);
+    }
+
+    SDL_SetRenderTarget(l->renderer, NULL);
+    return tex;
+}
+
+/* Release whatever bg_prepare() produced */
+static void bg_release(BackgroundSource *bg) {
+    if (bg->map) munmap(bg->map, bg->map_size);
+    if (bg->surface) SDL_FreeSurface(bg->surface);
+    bg->map = NULL;
+    bg->surface = NULL;
+    bg->scaled = 0;
+}
+
+/* Render thread half: turn the prepared wallpaper into the background texture */
+static SDL_Texture *load_background(Launcher *l, BackgroundSource *bg) {
+    SDL_Texture *tex = NULL;
+
+    if (bg->map) {
+        tex = bg_cache_upload(l, bg->map);
+    } else if (bg->surface && bg->scaled) {
+        tex = SDL_CreateTextureFromSurface(l->renderer, bg->surface);
+    } else if (bg->surface) {
+        tex = scale_background_gpu(l, &bg->surface);
+        if (tex && bg->cacheable) {
+            bg_cache_store_texture(l, tex, bg->cache_path, &bg->src, bg->key);
+        }
+    }
+    bg_release(bg);
+
+    return tex ? tex : create_gradient_background(l);
+}
+
+/* What the worker needs to know up front to pick GPU or CPU scaling. Returns 0 without info */
+static int bg_renderer_caps(SDL_Renderer *renderer, BackgroundSource *bg, SDL_RendererInfo *info) {
+    bg->gpu_scale = SDL_RenderTargetSupported(renderer);
+    if (SDL_GetRendererInfo(renderer, info) != 0) return 0;
+    bg->max_texture_w = info->max_texture_width;
+    bg->max_texture_h = info->max_texture_height;
+    return 1;
+}
+
+static void *bg_refresh_thread_func(void *arg) {
+    Launcher *l = (Launcher *)arg;
+    BackgroundRefresh *r = &l->bg_refresh;
+
+    bg_prepare(&r->bg, r->width, r->height);
+    if (!post_wake(l, WAKE_BACKGROUND, NULL)) atomic_store(&r->lost_wake, 1);
+    return NULL;
+}
+
+/* Prepare the wallpaper for the current size on a worker. Returns 0 if it couldn't start */
+static int bg_refresh_start(Launcher *l) {
+    BackgroundRefresh *r = &l->bg_refresh;
+    SDL_RendererInfo info;
+
+    if (r->started || l->wake_event == (Uint32)-1) return 0;
+    memset(&r->bg, 0, sizeof(r->bg));
+    bg_renderer_caps(l->renderer, &r->bg, &info);
+    r->width = l->width;
+    r->height = l->height;
+    atomic_store(&r->lost_wake, 0);
+    if (pthread_create(&r->thread, NULL, bg_refresh_thread_func, l) != 0) return 0;
+    r->started = 1;
+    return 1;
+}
+
+/* Wait out a refresh in flight and drop what it prepared */
+static void bg_refresh_discard(BackgroundRefresh *r) {
+    if (!r->started) return;
+    pthread_join(r->thread, NULL);
+    r->started = 0;
+    atomic_store(&r->lost_wake, 0);
+    bg_release(&r->bg);
+}
+
+/* ============ Font Loading ============ */
+
+/* Default paths - covers Arch, Debian, Ubuntu, Fedora */
+static const char *const sans_font_paths[] = {
+    "/usr/share/fonts/TTF/DejaVuSans.ttf",
+    "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+    "/usr/share/fonts/dejavu/DejaVuSans.ttf",
+    "/usr/share/fonts/noto/NotoSans-Regular.ttf",
+    "/usr/share/fonts/google-noto/NotoSans-Regular.ttf",
+    "/usr/share/fonts/Adwaita/AdwaitaSans-Regular.ttf",
+    "/usr/share/fonts/liberation/LiberationSans-Regular.ttf",
+    "/usr/share/fonts/TTF/LiberationSans-Regular.ttf",
+    NULL
+};
+
+static const char *const nerd_font_paths[] = {
+    "/usr/share/fonts/TTF/JetBrainsMonoNerdFont-Regular.ttf",
+    "/usr/share/fonts/TTF/JetBrainsMonoNerdFontMono-Regular.ttf",
+    "/usr/share/fonts/TTF/JetBrainsMonoNLNerdFont-Regular.ttf",
+    "/usr/share/fonts/TTF/JetBrainsMonoNLNerdFontMono-Regular.ttf",
+    NULL
+};
+
+/* Cheap sfnt signature check so a broken file falls through to the next path */
+static int font_magic_ok(const unsigned char *p, size_t size) {
+    if (size < 12) return 0;
+    return memcmp(p, "\x00\x01\x00\x00", 4) == 0 || memcmp(p, "true", 4) == 0 ||
+           memcmp(p, "OTTO", 4) == 0 || memcmp(p, "ttcf", 4) == 0;
+}
+
+/* Map the first usable file in paths. Returns 0 if none */
+static int font_file_map(FontFile *ff, const char *const *paths) {
+    for (int i = 0; paths[i]; i++) {
+        int fd = open(paths[i], O_RDONLY | O_CLOEXEC);
+        if (fd < 0) continue;
+
+        struct stat st;
+        void *p = MAP_FAILED;
+        if (fstat(fd, &st) == 0 && st.st_size > 0 && st.st_size <= INT32_MAX) {
+            p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);
+        if (p == MAP_FAILED) continue;
+
+        if (font_magic_ok(p, (size_t)st.st_size)) {
+            ff->data = p;
+            ff->size = (size_t)st.st_size;
+            return 1;
+        }
+        munmap(p, (size_t)st.st_size);
+    }
+    return 0;
+}
+
+static TTF_Font *font_open(FontRegistry *reg, FontFile *ff, int size) {
+    if (!ff->data || reg->num_open >= MAX_FONTS) return NULL;
+
+    /* The RWops is freed with the font; the mapping outlives both */
+    SDL_RWops *rw = SDL_RWFromConstMem(ff->data, (int)ff->size);
+    if (!rw) return NULL;
+    TTF_Font *f = TTF_OpenFontRW(rw, 1, size);
+    if (f) reg->open[reg->num_open++] = f;
+    return f;
+}
+
+static void font_registry_open(FontRegistry *reg) {
+    font_file_map(&reg->sans, sans_font_paths);
+    font_file_map(&reg->nerd, nerd_font_paths);
+}
+
+static void font_registry_close(FontRegistry *reg) {
+    for (int i = 0; i < reg->num_open; i++) {
+        TTF_CloseFont(reg->open[i]);
+    }
+    reg->num_open = 0;
+    if (reg->sans.data) munmap(reg->sans.data, reg->sans.size);
+    if (reg->nerd.data) munmap(reg->nerd.data, reg->nerd.size);
+    reg->sans.data = NULL;
+    reg->nerd.data = NULL;
+}
+
+/* Sizes are design points - opened at native scale so glyphs are never stretched */
+static TTF_Font *load_font(Launcher *l, int size) {
+    return font_open(&l->fonts, &l->fonts.sans, scale_px(l, size));
+}
+
+static TTF_Font *load_nerd_font(Launcher *l, int size) {
+    return font_open(&l->fonts, &l->fonts.nerd, scale_px(l, size));
+}
+
+/* ============ App Catalog ============ */
+
+/* Icon names accepted in apps.conf */
+static const struct {
+    const char *name;
+    const char *glyph;
+} icon_names[] = {
+    {"tv",        ICON_TV},
+    {"play",      ICON_PLAY},
+    {"video",     ICON_VIDEO},
+    {"music",     ICON_MUSIC},
+    {"bluetooth", ICON_BLUETOOTH},
+    {"settings",  ICON_SETTINGS},
+    {NULL, NULL}
+};
+
+/* One allocation for the App table followed by string space */
+static int catalog_alloc(Catalog *c, int max_apps, size_t string_bytes) {
+    c->block = malloc(max_apps * sizeof(App) + string_bytes);
+    if (!c->block) return 0;
+    c->apps = (App *)c->block;
+    c->num_apps = 0;
+    c->max_apps = max_apps;
+    c->strings = (char *)c->block + max_apps * sizeof(App);
+    c->strings_used = 0;
+    c->strings_size = string_bytes;
+    return 1;
+}
+
+static void catalog_free(Catalog *c) {
+    free(c->block);
+    memset(c, 0, sizeof(*c));
+}
+
+static const char *catalog_intern(Catalog *c, const char *str) {
+    size_t len = strlen(str) + 1;
+    if (c->strings_used + len > c->strings_size) return NULL;
+    char *p = c->strings + c->strings_used;
+    memcpy(p, str, len);
+    c->strings_used += len;
+    return p;
+}
+
+/* Arena bytes an argv needs beyond a copy of its command: $HOME expansions, pointers, alignment */
+static size_t catalog_argv_overhead(void) {
+    const char *home = getenv("HOME");
+    size_t home_len = home ? strlen(home) : 0;
+    return MAX_ARGS * home_len + (MAX_ARGS + 2) * sizeof(char *) + 1;
+}
+
+static int shell_word_char(char ch) {
+    return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') ||
+           (ch >= '0' && ch <= '9') || ch == '_';
+}
+
+/*
+ * Split a command the way /bin/sh would for the simple cases - blanks, quotes,
+ * backslashes, and a leading ~ or $HOME - straight into the arena. Anything
+ * else the shell would interpret returns NULL, and that app keeps using
+ * /bin/sh -c. Nothing is committed to the arena on failure.
+ */
+static char *const *catalog_argv(Catalog *c, const char *command) {
+    char *out = c->strings + c->strings_used;
+    char *const end = c->strings + c->strings_size;
+    const char *home = getenv("HOME");
+    char *words[MAX_ARGS];
+    int n = 0;
+
+#define PUT(ch) do { if (out >= end) return NULL; *out++ = (ch); } while (0)
+    for (const char *p = command;;) {
+        while (*p == ' ' || *p == '\t') p++;
+        if (!*p) break;
+        if (n == MAX_ARGS) return NULL;
+        words[n++] = out;
+
+        /* Home prefixes, expanded once here instead of by a shell on every launch */
+        int len = 0;
+        if (p[0] == '~' && (p[1] == '/' || p[1] == ' ' || p[1] == '\t' || !p[1])) {
+            len = 1;
+        } else if (strncmp(p, "$HOME", 5) == 0 && !shell_word_char(p[5])) {
+            len = 5;
+        }
+        if (len) {
+            if (!home) return NULL;
+            for (const char *h = home; *h; h++) PUT(*h);
+            p += len;
+        }
+
+        while (*p && *p != ' ' && *p != '\t') {
+            if (*p == '\'') {
+                for (p++; *p != '\''; p++) {
+                    if (!*p) return NULL;
+                    PUT(*p);
+                }
+                p++;
+            } else if (*p == '"') {
+                for (p++; *p != '"'; p++) {
+                    if (!*p || *p == '$' || *p == '`') return NULL;
+                    /* Only these are escapable in double quotes - elsewhere the backslash stays */
+                    if (*p == '\\' && p[1] && strchr("$`\"\\\n", p[1])) {
+                        if (*++p == '\n') continue;
+                    }
+                    PUT(*p);
+                }
+                p++;
+            } else if (*p == '\\') {
+                if (!p[1]) return NULL;
+                PUT(p[1]);
+                p += 2;
+            } else if (strchr("|&;<>()$`*?[]{}!#\n", *p)) {
+                return NULL;
+            } else {
+                PUT(*p++);
+            }
+        }
+        PUT('\0');
+    }
+#undef PUT
+
+    /* Nothing to run, or a leading VAR=value assignment */
+    if (n == 0 || strchr(words[0], '=')) return NULL;
+
+    size_t used = (size_t)(out - c->strings);
+    used = (used + sizeof(char *) - 1) & ~(sizeof(char *) - 1);
+    if (used + (n + 1) * sizeof(char *) > c->strings_size) return NULL;
+
+    char **argv = (char **)(c->strings + used);
+    memcpy(argv, words, n * sizeof(char *));
+    argv[n] = NULL;
+    c->strings_used = used + (n + 1) * sizeof(char *);
+    return argv;
+}
+
+static int catalog_add(Catalog *c, const char *name, const char *icon, const char *command,
+                       int warm) {
+    if (c->num_apps >= c->max_apps) return 0;
+    App *a = &c->apps[c->num_apps];
+    a->name = catalog_intern(c, name);
+    a->icon = catalog_intern(c, icon);
+    a->command = catalog_intern(c, command);
+    if (!a->name || !a->icon || !a->command) return 0;
+    a->warm = warm;
+    a->argv = catalog_argv(c, command);
+    c->num_apps++;
+    return 1;
+}
+
+/* Icon field: a name from icon_names, U+XXXX, or the glyph itself */
+static const char *catalog_icon(const char *field, char utf8[5]) {
+    for (int i = 0; icon_names[i].name; i++) {
+        if (strcasecmp(field, icon_names[i].name) == 0) return icon_names[i].glyph;
+    }
+
+    if ((field[0] == 'U' || field[0] == 'u') && field[1] == '+') {
+        char *end;
+        unsigned long cp = strtoul(field + 2, &end, 16);
+        if (*end == '\0' && cp > 0 && cp <= 0x10FFFF) {
+            unsigned char *o = (unsigned char *)utf8;
+            if (cp < 0x80) {
+                *o++ = cp;
+            } else if (cp < 0x800) {
+                *o++ = 0xC0 | (cp >> 6);
+                *o++ = 0x80 | (cp & 0x3F);
+            } else if (cp < 0x10000) {
+                *o++ = 0xE0 | (cp >> 12);
+                *o++ = 0x80 | ((cp >> 6) & 0x3F);
+                *o++ = 0x80 | (cp & 0x3F);
+            } else {
+                *o++ = 0xF0 | (cp >> 18);
+                *o++ = 0x80 | ((cp >> 12) & 0x3F);
+                *o++ = 0x80 | ((cp >> 6) & 0x3F);
+                *o++ = 0x80 | (cp & 0x3F);
+            }
+            *o = '\0';
+            return utf8;
+        }
+    }
+    return field;
+}
+
+/*
+ * apps.conf holds one "Name | icon | command [| warm]" entry per line, '#'
+ * starts a comment line. The command is the rest of the line, so it may
+ * contain '|'; only a final field of exactly "warm" is taken as the flag.
+ * Returns 0 if the file is missing or has no usable entries.
+ */
+static int catalog_load_file(Catalog *c, const char *path) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return 0;
+
+    struct stat st;
+    char *text = NULL;
+    ssize_t len = -1;
+    if (fstat(fd, &st) == 0 && st.st_size > 0 && st.st_size <= 1 << 20) {
+        text = malloc((size_t)st.st_size + 1);
+        if (text) len = pread(fd, text, (size_t)st.st_size, 0);
+    }
+    close(fd);
+    if (len <= 0) {
+        free(text);
+        return 0;
+    }
+    text[len] = '\0';
+
+    /*
+     * Strings never outgrow their line: separators become NULs, icons expand
+     * to <= 4 bytes. Each argv is at most a second copy of its command.
+     */
+    int lines = 1;
+    for (ssize_t i = 0; i < len; i++) lines += text[i] == '\n';
+    int max_apps = lines < MAX_APPS ? lines : MAX_APPS;
+    size_t bytes = 2 * (size_t)len + 8 * (size_t)lines + 1 + max_apps * catalog_argv_overhead();
+    if (!catalog_alloc(c, max_apps, bytes)) {
+        free(text);
+        return 0;
+    }
+
+    int lineno = 0;
+    for (char *line = text, *next; line; line = next) {
+        next = strchr(line, '\n');
+        if (next) *next++ = '\0';
+        lineno++;
+
+        line = trim(line);
+        if (*line == '\0' || *line == '#') continue;
+
+        char *icon = strchr(line, '|');
+        char *command = icon ? strchr(icon + 1, '|') : NULL;
+        if (!command) {
+            fprintf(stderr, "Warning: %s:%d: expected 'Name | icon | command'\n", path, lineno);
+            continue;
+        }
+        *icon++ = '\0';
+        *command++ = '\0';
+
+        /* Optional trailing flag */
+        int warm = 0;
+        char *flag = strrchr(command, '|');
+        if (flag && strcmp(trim(flag + 1), "warm") == 0) {
+            *flag = '\0';
+            warm = 1;
+        }
+
+        char utf8[5];
+        const char *name = trim(line);
+        command = trim(command);
+        if (!*name || !*command) continue;
+        if (!catalog_add(c, name, catalog_icon(trim(icon), utf8), command, warm)) {
+            fprintf(stderr, "Warning: %s: only the first %d apps are used\n", path, c->max_apps);
+            break;
+        }
+    }
+    free(text);
+
+    if (c->num_apps == 0) {
+        catalog_free(c);
+        return 0;
+    }
+    return 1;
+}
+
+static int catalog_load(Catalog *c) {
+    char path[512];
+    if (config_path(path, sizeof(path), "apps.conf") && catalog_load_file(c, path)) return 1;
+
+    size_t bytes = 0;
+    for (int i = 0; i < NUM_DEFAULT_APPS; i++) {
+        bytes += strlen(default_apps[i].name) + strlen(default_apps[i].icon) +
+                 2 * strlen(default_apps[i].command) + 4 + catalog_argv_overhead();
+    }
+    if (!catalog_alloc(c, NUM_DEFAULT_APPS, bytes)) return 0;
+    for (int i = 0; i < NUM_DEFAULT_APPS; i++) {
+        const App *a = &default_apps[i];
+        catalog_add(c, a->name, a->icon, a->command, a->warm);
+    }
+    return 1;
+}
+
+/* ============ Confirmation Dialog ============ */
+
+/* Compose each dialog once - panel, border, title and hint - so opening one is a single quad */
+/* Design-pixel border width; all but the outermost pixel of it lies inside the texture */
+#define DIALOG_BORDER 2
+
+static void build_dialogs(Launcher *l, Startup *s) {
+    int w = scale_px(l, DIALOG_W), h = scale_px(l, DIALOG_H);
+    int border = scale_px(l, DIALOG_BORDER);
+    int inset = border - 1;
+
+    for (int m = MODAL_NONE + 1; m < NUM_MODALS; m++) {
+        SDL_Texture *tex = SDL_CreateTexture(l->renderer, SDL_PIXELFORMAT_RGBA8888,
+                                             SDL_TEXTUREACCESS_TARGET, w + 2 * inset, h + 2 * inset);
+        if (!tex) continue;
+
+        SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+        SDL_SetRenderTarget(l->renderer, tex);
+        SDL_SetRenderDrawColor(l->renderer, 0, 0, 0, 0);
+        SDL_RenderClear(l->renderer);
+
+        /* Dialog, inset by the outer border pixels */
+        SDL_Rect dialog = {inset, inset, w, h};
+        draw_rounded_rect(l->renderer, &dialog, scale_px(l, 20), 0x1A, 0x1E, 0x33, 0xF0);
+
+        /* Border */
+        SDL_SetRenderDrawColor(l->renderer, COL_ACCENT);
+        for (int b = 0; b < border; b++) {
+            SDL_Rect br = {inset - b, inset - b, w + 2*b, h + 2*b};
+            SDL_RenderDrawRect(l->renderer, &br);
+        }
+
+        /* Title and hint */
+        blit_texture_centered(l, s->dialog_title[m], inset + w / 2, inset + scale_px(l, 60));
+        blit_texture_centered(l, s->dialog_hint, inset + w / 2, inset + scale_px(l, 130));
+
+        SDL_SetRenderTarget(l->renderer, NULL);
+        l->dialogs[m] = tex;
+    }
+
+    for (int m = 0; m < NUM_MODALS; m++) {
+        if (s->dialog_title[m]) SDL_DestroyTexture(s->dialog_title[m]);
+        s->dialog_title[m] = NULL;
+    }
+    if (s->dialog_hint) SDL_DestroyTexture(s->dialog_hint);
+    s->dialog_hint = NULL;
+}
+
+/* Drawn on the screen over the copied frame, so the scene underneath keeps updating */
+static void draw_modal(Launcher *l) {
+    /* Darken background */
+    SDL_SetRenderDrawBlendMode(l->renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(l->renderer, 0, 0, 0, 180);
+    SDL_Rect full = {0, 0, l->width, l->height};
+    SDL_RenderFillRect(l->renderer, &full);
+
+    int w = scale_px(l, DIALOG_W), h = scale_px(l, DIALOG_H);
+    int inset = scale_px(l, DIALOG_BORDER) - 1;
+    SDL_Rect dst = {(l->width - w) / 2 - inset, (l->height - h) / 2 - inset,
+                    w + 2 * inset, h + 2 * inset};
+    SDL_RenderCopy(l->renderer, l->dialogs[l->modal], NULL, &dst);
+}
+
+/* ============ Stats History ============ */
+
+static int get_stat_level(int value, int is_temp) {
+    if (is_temp) {
+        if (value >= 70) return LEVEL_RED;
+        if (value >= 55) return LEVEL_ORANGE;
+        if (value >= 45) return LEVEL_YELLOW;
+        return LEVEL_GREEN;
+    } else {
+        if (value >= 80) return LEVEL_RED;
+        if (value >= 60) return LEVEL_YELLOW;
+        return LEVEL_GREEN;
+    }
+}
+
+/* Streaming health - green without a probe, red while the host is unreachable */
+static int rtt_level(int rtt) {
+    if (rtt < 0) return LEVEL_RED;
+    if (rtt >= RTT_BAD_MS) return LEVEL_ORANGE;
+    if (rtt >= RTT_WARN_MS) return LEVEL_YELLOW;
+    return LEVEL_GREEN;
+}
+
+static Uint32 pack_rgba8888(SDL_Color c, Uint8 a) {
+    return (Uint32)c.r << 24 | (Uint32)c.g << 16 | (Uint32)c.b << 8 | a;
+}
+
+/* Texture column of one history slot: a bar per stat band, coloured by its level */
+static void sparkline_column(Launcher *l, int slot, Uint32 *pixels, int pitch) {
+    int band = l->spark_band;
+    for (int i = 0; i < NUM_STATS; i++) {
+        int v = l->history.values[i][slot];
+        /* Throughput has no severity of its own */
+        SDL_Color c = i == STAT_NET ? make_color(COL_CYAN) : level_color(get_stat_level(v, i == STAT_TEMP));
+        int bar = (v * band + 50) / 100;
+        if (v > 0 && bar < 1) bar = 1;
+        for (int y = 0; y < band; y++) {
+            int height = band - y;          /* 1 at the bottom row */
+            Uint8 a = height > bar ? 0 : height == bar ? 0xFF : 0x60;
+            pixels[(i * band + y) * pitch] = pack_rgba8888(c, a);
+        }
+    }
+}
+
+/* Render thread: upload the whole history once, the ticks then only touch one column */
+static void sparklines_create(Launcher *l) {
+    int band = scale_px(l, SPARK_BAND);
+    Uint32 *pixels = malloc(sizeof(Uint32) * HISTORY_LEN * NUM_STATS * (size_t)band);
+    if (!pixels) return;
+
+    l->sparklines = SDL_CreateTexture(l->renderer, SDL_PIXELFORMAT_RGBA8888,
+                                      SDL_TEXTUREACCESS_STREAMING, HISTORY_LEN, NUM_STATS * band);
+    if (l->sparklines) {
+        l->spark_band = band;
+        for (int x = 0; x < HISTORY_LEN; x++) {
+            sparkline_column(l, x, pixels + x, HISTORY_LEN);
+        }
+        SDL_UpdateTexture(l->sparklines, NULL, pixels, HISTORY_LEN * (int)sizeof(Uint32));
+        SDL_SetTextureBlendMode(l->sparklines, SDL_BLENDMODE_BLEND);
+    }
+    free(pixels);
+}
+
+/* Main thread, on a stats wake that brings a new column - constant cost whatever the history length */
+static void history_push(Launcher *l, const StatsSample *s) {
+    StatsHistory *h = &l->history;
+    if (!s->timestamp || s->columns == h->columns) return;
+    h->columns = s->columns;
+
+    int v[NUM_STATS] = {s->cpu, s->mem, s->temp, s->disk, s->io_util, s->net_mbits, s->swap};
+    int slot = (int)(h->count % HISTORY_LEN);
+    for (int i = 0; i < NUM_STATS; i++) {
+        h->values[i][slot] = (Uint8)(v[i] < 0 ? 0 : v[i] > 100 ? 100 : v[i]);
+    }
+    h->count++;
+
+    /* While the scene is released the next sparklines_create() uploads it all */
+    if (!l->sparklines) return;
+    Uint32 column[NUM_STATS * SPARK_BAND * (int)SCALE_MAX];
+    SDL_Rect r = {slot, 0, 1, NUM_STATS * l->spark_band};
+    sparkline_column(l, slot, column, 1);
+    SDL_UpdateTexture(l->sparklines, &r, column, (int)sizeof(Uint32));
+}
+
+/* The ring is rotated in place: oldest slot (the next to be written) on the left */
+static void draw_sparkline(Launcher *l, int stat, int cx, int y) {
+    if (!l->sparklines) return;
+
+    int w = scale_px(l, HISTORY_LEN), band = l->spark_band;
+    int head = (int)(l->history.count % HISTORY_LEN);
+    int split = w * (HISTORY_LEN - head) / HISTORY_LEN;
+    int x = cx - w / 2;
+
+    SDL_Rect src_old = {head, stat * band, HISTORY_LEN - head, band};
+    SDL_Rect dst_old = {x, y, split, band};
+    SDL_RenderCopy(l->renderer, l->sparklines, &src_old, &dst_old);
+    if (head == 0) return;
+
+    SDL_Rect src_new = {0, stat * band, head, band};
+    SDL_Rect dst_new = {x + split, y, w - split, band};
+    SDL_RenderCopy(l->renderer, l->sparklines, &src_new, &dst_new);
+}
+
+/* ============ Cache Creation ============ */
+
+/* Rasterize now, upload to *texture once the render thread picks it up */
+static void queue_surface(Startup *s, SDL_Texture **texture, SDL_Surface *surf) {
+    if (!surf) return;
+    if (s->num_uploads >= MAX_PENDING_UPLOADS) {
+        SDL_FreeSurface(surf);
+        return;
+    }
+    s->uploads[s->num_uploads].surface = surf;
+    s->uploads[s->num_uploads].texture = texture;
+    s->num_uploads++;
+}
+
+static void queue_text(Startup *s, SDL_Texture **texture, TTF_Font *font, const char *text,
+                       SDL_Color color) {
+    queue_surface(s, texture, TTF_RenderUTF8_Blended(font, text, color));
+}
+
+/* Startup worker half: every text and glyph surface, no renderer calls */
+static void rasterize_surfaces(Launcher *l, Startup *s) {
+    SDL_Color fg = make_color(COL_FG);
+    SDL_Color fg_dim = make_color(COL_FG_DIM);
+
+    /* Tile labels and icons for the first page - tiles_sync() trims it to what's visible */
+    for (int i = 0; i < MAX_VISIBLE_TILES; i++) {
+        TileTextures *t = &l->tile_tex[i];
+        t->app = i < l->catalog.num_apps ? i : -1;
+        if (t->app < 0) continue;
+        const App *a = &l->catalog.apps[i];
+        queue_text(s, &t->label, l->font_tile, a->name, fg);
+        queue_text(s, &t->icon, l->font_icon, a->icon, fg);
+        queue_text(s, &t->icon_dim, l->font_icon, a->icon, fg_dim);
+    }
+
+    /* Settings icon */
+    queue_text(s, &l->settings_icon, l->font_icon, ICON_SETTINGS, fg);
+    queue_text(s, &l->settings_icon_dim, l->font_icon, ICON_SETTINGS, fg_dim);
+
+    /* Stat labels */
+    const char *stat_names[NUM_STATS] = {"CPU", "RAM", "TEMP", "DISK", "I/O", "NET", "SWAP"};
+    for (int i = 0; i < NUM_STATS; i++) {
+        queue_text(s, &l->stat_labels[i], l->font_stat_label, stat_names[i], fg_dim);
+    }
+    queue_text(s, &l->throttled_label, l->font_stat_label, "THROTTLED", make_color(COL_RED));
+
+    /* Glyph atlases - clock digits, and stat values/icons in every severity color */
+    queue_surface(s, &l->clock_atlas.texture,
+                  rasterize_glyph_atlas(&l->clock_atlas, l->font_clock, fg, 0, GLYPH_COLON));
+    for (int i = 0; i < NUM_LEVELS; i++) {
+        SDL_Color col = level_color(i);
+        queue_surface(s, &l->value_atlas[i].texture,
+                      rasterize_glyph_atlas(&l->value_atlas[i], l->font_stat_value, col,
+                                            0, GLYPH_MBITS));
+        queue_surface(s, &l->stat_icon_atlas[i].texture,
+                      rasterize_glyph_atlas(&l->stat_icon_atlas[i], l->font_icon_small, col,
+                                            GLYPH_ICON_CPU, GLYPH_ICON_SWAP));
+    }
+
+    /* Help text */
+    queue_text(s, &l->help_text, l->font_tile, "?", fg_dim);
+
+    /* Confirmation dialog text - composed into one texture per dialog later */
+    for (int m = MODAL_NONE + 1; m < NUM_MODALS; m++) {
+        queue_text(s, &s->dialog_title[m], l->font_date, modal_actions[m].title, fg);
+    }
+    queue_text(s, &s->dialog_hint, l->font_tile, "Enter = Yes    Esc = No", fg_dim);
+
+    /* Selection outlines - one quad each instead of per-frame point/rect loops */
+    int tile_w = scale_px(l, TILE_WIDTH), tile_h = scale_px(l, TILE_HEIGHT);
+    int outset = scale_px(l, 2);
+    queue_surface(s, &l->settings_ring,
+                  rasterize_ring(scale_px(l, 58), 27.0f * l->scale, 3.0f * l->scale,
+                                 make_color(COL_PINK)));
+    queue_surface(s, &l->tile_border_selected,
+                  rasterize_border(tile_w + 2 * outset, tile_h + 2 * outset, scale_px(l, 3),
+                                   make_color(COL_PINK)));
+    queue_surface(s, &l->tile_border_normal,
+                  rasterize_border(tile_w, tile_h, scale_px(l, 1), make_color(0x42, 0x47, 0x61, 0x50)));
+}
+
+/* Render thread half: shape textures plus the GPU uploads queued by the worker */
+static void cache_surfaces(Launcher *l, Startup *s) {
+    /* Tile backgrounds */
+    int tile_w = scale_px(l, TILE_WIDTH), tile_h = scale_px(l, TILE_HEIGHT);
+    int tile_r = scale_px(l, TILE_RADIUS);
+    l->tile_bg_normal = create_rounded_rect_texture(l, tile_w, tile_h, tile_r, COL_BG_TILE);
+    l->tile_bg_selected = create_rounded_rect_texture(l, tile_w, tile_h, tile_r, COL_BG_TILE_SEL);
+
+    /* Settings backgrounds */
+    l->settings_bg_normal = create_rounded_rect_texture(l, scale_px(l, 50), scale_px(l, 50),
+                                                         scale_px(l, 25), 0x1A, 0x1E, 0x33, 0x96);
+    l->settings_bg_selected = create_rounded_rect_texture(l, scale_px(l, 56), scale_px(l, 56),
+                                                           scale_px(l, 28), 0x2D, 0x34, 0x50, 0xC8);
+
+    /* Stats bar background - more visible */
+    l->stats_bar_w = scale_px(l, STAT_WIDTH * NUM_STATS);  /* Python: 580 for four */
+    l->stats_bar_h = scale_px(l, 150);  /* Python: 120, plus the sparkline row */
+    l->stats_bar_bg = create_rounded_rect_texture(l, l->stats_bar_w, l->stats_bar_h, scale_px(l, 20),
+                                                   0x1A, 0x1E, 0x33, 0xC8);  /* radius=20, alpha=200 like Python */
+
+    for (int i = 0; i < s->num_uploads; i++) {
+        PendingUpload *u = &s->uploads[i];
+        *u->texture = SDL_CreateTextureFromSurface(l->renderer, u->surface);
+        if (*u->texture) SDL_SetTextureBlendMode(*u->texture, SDL_BLENDMODE_BLEND);
+        SDL_FreeSurface(u->surface);
+    }
+    s->num_uploads = 0;
+
+    build_dialogs(l, s);
+    sparklines_create(l);
+
+    l->date_yday = -1;
+}
+
+/* ============ Layout Calculation ============ */
+
+/* Fit the 1080p design into the display, in SCALE_STEP increments */
+static float layout_scale(int width, int height) {
+    float sx = (float)width / DESIGN_WIDTH, sy = (float)height / DESIGN_HEIGHT;
+    float scale = roundf((sx < sy ? sx : sy) / SCALE_STEP) * SCALE_STEP;
+    if (scale < SCALE_MIN) scale = SCALE_MIN;
+    if (scale > SCALE_MAX) scale = SCALE_MAX;
+    return scale;
+}
+
+static void calc_layout(Launcher *l) {
+    int n = l->catalog.num_apps;
+    int tile_w = scale_px(l, TILE_WIDTH), tile_h = scale_px(l, TILE_HEIGHT);
+    int spacing = scale_px(l, TILE_SPACING);
+
+    l->stats_bar_x = (l->width - l->stats_bar_w) / 2;
+    /* Use larger margin for TV overscan - 120px from bottom */
+    l->stats_bar_y = l->height - l->stats_bar_h - scale_px(l, 120);
+
+    /* As many columns as fit the overscan margins, as many rows as fit above the stats bar */
+    int cols = (l->width - 2 * scale_px(l, GRID_MARGIN) + spacing) / (tile_w + spacing);
+    if (cols > GRID_MAX_COLS) cols = GRID_MAX_COLS;
+    if (cols < 1) cols = 1;
+
+    int grid_y = (int)(l->height * 0.48);
+    int total_rows = (n + cols - 1) / cols;
+    int rows = (l->stats_bar_y - scale_px(l, 20) - grid_y + spacing) / (tile_h + spacing);
+    if (rows > GRID_MAX_ROWS) rows = GRID_MAX_ROWS;
+    if (rows > total_rows) rows = total_rows;
+    if (rows < 1) rows = 1;
+
+    l->grid_cols = cols;
+    l->grid_rows = rows;
+    if (l->scroll_row > total_rows - rows) l->scroll_row = total_rows - rows;
+    if (l->scroll_row < 0) l->scroll_row = 0;
+
+    /* A catalog shorter than one row is centred on its own tiles */
+    int row_tiles = n < cols ? n : cols;
+    int total_w = row_tiles * tile_w + (row_tiles - 1) * spacing;
+    int grid_x = (l->width - total_w) / 2;
+
+    for (int i = 0; i < MAX_VISIBLE_TILES; i++) {
+        SDL_Rect *r = &l->tile_rects[i];
+        if (i < cols * rows) {
+            *r = (SDL_Rect){grid_x + (i % cols) * (tile_w + spacing),
+                            grid_y + (i / cols) * (tile_h + spacing),
+                            tile_w, tile_h};
+        } else {
+            *r = (SDL_Rect){0, 0, 0, 0};
+        }
+    }
+
+    /* Dirty regions - each covers everything its element can touch */
+    l->regions[REGION_BACKGROUND] = (SDL_Rect){0, 0, l->width, l->height};
+
+    int clock_y = (int)(l->height * 0.12);
+    int date_h = l->font_date ? TTF_FontHeight(l->font_date) : 0;
+    l->regions[REGION_CLOCK] = (SDL_Rect){0, clock_y, l->width,
+                                          l->clock_atlas.height + scale_px(l, 5) + date_h};
+
+    /* Selected background is 56x56 with the pink ring reaching radius 28 */
+    int ring = scale_px(l, 29);
+    l->regions[REGION_SETTINGS] = (SDL_Rect){l->width - scale_px(l, 60) - ring, scale_px(l, 50) - ring,
+                                             scale_px(l, 58), scale_px(l, 58)};
+
+    l->regions[REGION_MODAL] = (SDL_Rect){0, 0, l->width, l->height};
+    l->regions[REGION_STATS] = (SDL_Rect){l->stats_bar_x, l->stats_bar_y,
+                                          l->stats_bar_w, l->stats_bar_h};
+
+    /* Selected tiles draw a 3px border outside the tile rect */
+    int border = scale_px(l, 3);
+    for (int i = 0; i < MAX_VISIBLE_TILES; i++) {
+        SDL_Rect *r = &l->tile_rects[i];
+        l->regions[REGION_TILE_FIRST + i] = SDL_RectEmpty(r) ? *r :
+            (SDL_Rect){r->x - border, r->y - border, r->w + 2 * border, r->h + 2 * border};
+    }
+}
+
+static void invalidate(Launcher *l, Uint32 mask) {
+    l->dirty |= mask;
+}
+
+/* Catalog index shown in an on-screen slot, -1 if the slot is empty */
+static int slot_app(Launcher *l, int slot) {
+    if (slot < 0 || slot >= l->grid_cols * l->grid_rows) return -1;
+    int app = l->scroll_row * l->grid_cols + slot;
+    return app < l->catalog.num_apps ? app : -1;
+}
+
+/* On-screen slot of a catalog entry, -1 while it is scrolled out */
+static int app_slot(Launcher *l, int app) {
+    int slot = app - l->scroll_row * l->grid_cols;
+    return slot >= 0 && slot < l->grid_cols * l->grid_rows ? slot : -1;
+}
+
+/* Region holding the current selection highlight */
+static Uint32 selection_region(Launcher *l) {
+    if (l->settings_selected) return REGION_BIT(REGION_SETTINGS);
+    int slot = app_slot(l, l->selected);
+    return slot >= 0 ? REGION_BIT(REGION_TILE_FIRST + slot) : REGION_TILES;
+}
+
+static TileTextures *tile_textures(Launcher *l, int app) {
+    for (int i = 0; i < MAX_VISIBLE_TILES; i++) {
+        if (l->tile_tex[i].app == app) return &l->tile_tex[i];
+    }
+    return NULL;
+}
+
+static void tile_textures_release(TileTextures *t) {
+    if (t->label) SDL_DestroyTexture(t->label);
+    if (t->icon) SDL_DestroyTexture(t->icon);
+    if (t->icon_dim) SDL_DestroyTexture(t->icon_dim);
+    memset(t, 0, sizeof(*t));
+    t->app = -1;
+}
+
+/* Keep label/icon textures resident for exactly the visible apps */
+static void tiles_sync(Launcher *l) {
+    for (int i = 0; i < MAX_VISIBLE_TILES; i++) {
+        TileTextures *t = &l->tile_tex[i];
+        if (t->app >= 0 && app_slot(l, t->app) < 0) tile_textures_release(t);
+    }
 
-static void cache_surfaces(Launcher *l) {
     SDL_Color fg = make_color(COL_FG);
     SDL_Color fg_dim = make_color(COL_FG_DIM);
+    for (int slot = 0; slot < MAX_VISIBLE_TILES; slot++) {
+        int app = slot_app(l, slot);
+        if (app < 0 || tile_textures(l, app)) continue;
+
+        /* At most MAX_VISIBLE_TILES apps are visible, so a free entry exists */
+        TileTextures *t = tile_textures(l, -1);
+        const App *a = &l->catalog.apps[app];
+        t->app = app;
+        t->label = render_text(l, l->font_tile, a->name, fg);
+        t->icon = render_text(l, l->font_icon, a->icon, fg);
+        t->icon_dim = render_text(l, l->font_icon, a->icon, fg_dim);
+    }
+}
+
+/* Scroll by whole rows until the selected app is on screen */
+static void scroll_to_selection(Launcher *l) {
+    int row = l->selected / l->grid_cols;
+    int scroll = l->scroll_row;
+    if (row < scroll) scroll = row;
+    if (row >= scroll + l->grid_rows) scroll = row - l->grid_rows + 1;
+    if (scroll == l->scroll_row) return;
+
+    l->scroll_row = scroll;
+    tiles_sync(l);
+    invalidate(l, REGION_TILES);
+}
+
+/* ============ Animation ============ */
+
+static float tween_value(const Tween *t, Uint32 now) {
+    Uint32 elapsed = now - t->start;
+    if (t->duration == 0 || elapsed >= t->duration) return t->to;
+
+    /* Ease-out cubic */
+    float p = 1.0f - (float)elapsed / t->duration;
+    return t->from + (t->to - t->from) * (1.0f - p * p * p);
+}
+
+/* Retarget from wherever the value is right now, so interrupted moves stay smooth */
+static void tween_start(Tween *t, float to, Uint32 duration, Uint32 now) {
+    t->from = tween_value(t, now);
+    t->to = to;
+    t->start = now;
+    t->duration = duration;
+    t->active = 1;
+}
+
+static void tween_set(Tween *t, float value) {
+    t->from = t->to = value;
+    t->duration = 0;
+    t->active = 1;
+}
+
+/* Clear a tween once its final value has been drawn. Returns 1 while it still moves */
+static int tween_advance(Tween *t, Uint32 now) {
+    if (now - t->start >= t->duration) {
+        t->active = 0;
+        return 0;
+    }
+    return 1;
+}
+
+static int selection_target(Launcher *l) {
+    return l->settings_selected ? SEL_SETTINGS : l->selected;
+}
+
+static float selection_amount(Launcher *l, int target) {
+    return tween_value(&l->sel_fade[target], l->anim_now);
+}
+
+/* Tile border position, snapped to the current selection */
+static SDL_Rect highlight_rect(Launcher *l) {
+    return (SDL_Rect){(int)(tween_value(&l->highlight_x, l->anim_now) + 0.5f),
+                      (int)(tween_value(&l->highlight_y, l->anim_now) + 0.5f),
+                      scale_px(l, TILE_WIDTH) + 2 * scale_px(l, 2),
+                      scale_px(l, TILE_HEIGHT) + 2 * scale_px(l, 2)};
+}
+
+/* Move the highlight onto the selected tile, sliding there if animate */
+static void highlight_to_selection(Launcher *l, int animate, Uint32 now) {
+    SDL_Rect *r = &l->tile_rects[app_slot(l, l->selected)];
+    int outset = scale_px(l, 2);
+    if (animate) {
+        tween_start(&l->highlight_x, r->x - outset, ANIM_SLIDE_MS, now);
+        tween_start(&l->highlight_y, r->y - outset, ANIM_SLIDE_MS, now);
+    } else {
+        tween_set(&l->highlight_x, r->x - outset);
+        tween_set(&l->highlight_y, r->y - outset);
+    }
+}
+
+/* Settle everything on the current selection without animating */
+static void anim_reset(Launcher *l) {
+    int target = selection_target(l);
+    for (int i = 0; i <= SEL_SETTINGS; i++) {
+        tween_set(&l->sel_fade[i], i == target ? 1.0f : 0.0f);
+    }
+    highlight_to_selection(l, 0, 0);
+}
+
+/* Kick off the transitions for a selection change away from prev_target */
+static void anim_select(Launcher *l, int prev_target) {
+    int target = selection_target(l);
+    if (target == prev_target) return;
+
+    Uint32 now = SDL_GetTicks();
+    tween_start(&l->sel_fade[prev_target], 0.0f, ANIM_FADE_MS, now);
+    tween_start(&l->sel_fade[target], 1.0f, ANIM_FADE_MS, now);
+
+    /* The border slides between tiles, and fades in place coming back from settings */
+    if (target != SEL_SETTINGS) highlight_to_selection(l, prev_target != SEL_SETTINGS, now);
+}
+
+/* Advance to now and invalidate whatever moves. Returns 1 while any tween is still running */
+static int anim_step(Launcher *l) {
+    Uint32 now = SDL_GetTicks();
+    int running = 0;
+
+    l->anim_now = now;
+    for (int i = 0; i <= SEL_SETTINGS; i++) {
+        Tween *t = &l->sel_fade[i];
+        if (!t->active) continue;
+        if (i == SEL_SETTINGS) {
+            invalidate(l, REGION_BIT(REGION_SETTINGS));
+        } else if (app_slot(l, i) >= 0) {
+            invalidate(l, REGION_BIT(REGION_TILE_FIRST + app_slot(l, i)));
+        }
+        running |= tween_advance(t, now);
+    }
+
+    if (l->highlight_x.active || l->highlight_y.active) {
+        invalidate(l, REGION_TILES);
+        if (l->highlight_x.active) running |= tween_advance(&l->highlight_x, now);
+        if (l->highlight_y.active) running |= tween_advance(&l->highlight_y, now);
+    }
+    return running;
+}
+
+/* ============ Drawing ============ */
+
+static void draw_clock(Launcher *l) {
+    time_t now = time(NULL);
+    struct tm *t = localtime(&now);
+
+    int clock_glyphs[5] = {
+        t->tm_hour / 10, t->tm_hour % 10, GLYPH_COLON, t->tm_min / 10, t->tm_min % 10
+    };
+    int clock_w = glyph_run_width(&l->clock_atlas, clock_glyphs, 5);
+    int clock_h = l->clock_atlas.height;
+    int clock_y = (int)(l->height * 0.12);
+    /* Python blits at top-left, so clock_y is top of text */
+    draw_glyph_run(l, &l->clock_atlas, clock_glyphs, 5, (l->width - clock_w) / 2, clock_y);
+
+    /* Date - only re-rasterized when the day changes */
+    if (!l->date_text || t->tm_yday != l->date_yday) {
+        char buf[64];
+        strftime(buf, sizeof(buf), "%A, %B %d", t);
+        if (l->date_text) SDL_DestroyTexture(l->date_text);
+        l->date_text = render_text(l, l->font_date, buf, make_color(COL_FG));
+        l->date_yday = t->tm_yday;
+    }
+
+    /* Date - positioned right below clock with 5px gap */
+    if (l->date_text) {
+        int date_w, date_h;
+        SDL_QueryTexture(l->date_text, NULL, NULL, &date_w, &date_h);
+        int date_y = clock_y + clock_h + scale_px(l, 5);
+        SDL_Rect date_dst = {(l->width - date_w) / 2, date_y, date_w, date_h};
+        SDL_RenderCopy(l->renderer, l->date_text, NULL, &date_dst);
+    }
+}
+
+static void draw_settings(Launcher *l) {
+    int settings_x = l->width - scale_px(l, 60);
+    int settings_y = scale_px(l, 50);
+    float sel = selection_amount(l, SEL_SETTINGS);
+
+    /* Cross-fade the resting and selected look, growing 50 -> 56 px */
+    int half = scale_px(l, 25) + (int)(3.0f * l->scale * sel + 0.5f);
+    SDL_Rect dst = {settings_x - half, settings_y - half, 2 * half, 2 * half};
+    render_copy_alpha(l, l->settings_bg_normal, &dst, 1.0f - sel);
+    render_copy_alpha(l, l->settings_bg_selected, &dst, sel);
+
+    /* Pink circle border */
+    int ring_half = scale_px(l, 29);
+    SDL_Rect ring = {settings_x - ring_half, settings_y - ring_half, scale_px(l, 58), scale_px(l, 58)};
+    render_copy_alpha(l, l->settings_ring, &ring, sel);
+
+    blit_texture_centered_alpha(l, l->settings_icon_dim, settings_x, settings_y, 1.0f - sel);
+    blit_texture_centered_alpha(l, l->settings_icon, settings_x, settings_y, sel);
+}
+
+static void draw_tile(Launcher *l, int slot) {
+    int app = slot_app(l, slot);
+    SDL_Rect *r = &l->tile_rects[slot];
+    TileTextures *t = tile_textures(l, app);
+    float sel = selection_amount(l, app);
+
+    /* Background */
+    render_copy_alpha(l, l->tile_bg_normal, r, 1.0f - sel);
+    render_copy_alpha(l, l->tile_bg_selected, r, sel);
+
+    /* Border - the selected one is the sliding highlight, drawn after all tiles */
+    render_copy_alpha(l, l->tile_border_normal, r, 1.0f - sel);
+
+    /* Icon */
+    int icon_y = r->y + r->h / 2 - scale_px(l, 15);
+    if (!t) return;
+    blit_texture_centered_alpha(l, t->icon_dim, r->x + r->w / 2, icon_y, 1.0f - sel);
+    blit_texture_centered_alpha(l, t->icon, r->x + r->w / 2, icon_y, sel);
+
+    /* Label - Python uses rect.bottom - 35 */
+    blit_texture_centered(l, t->label, r->x + r->w / 2, r->y + r->h - scale_px(l, 35));
+}
+
+static void draw_stats_bar(Launcher *l) {
+    SDL_Rect stats_dst = {l->stats_bar_x, l->stats_bar_y, l->stats_bar_w, l->stats_bar_h};
+    SDL_RenderCopy(l->renderer, l->stats_bar_bg, NULL, &stats_dst);
+
+    StatsSample snap;
+    stats_snapshot(&l->stats.published, &snap);
+
+    int stat_values[NUM_STATS] = {snap.cpu, snap.mem, snap.temp, snap.disk, snap.io_mbps,
+                                  snap.net_mbits, snap.swap};
+    const int stat_units[NUM_STATS] = {GLYPH_PERCENT, GLYPH_PERCENT, GLYPH_CELSIUS, GLYPH_PERCENT,
+                                       GLYPH_MBPS, GLYPH_MBITS, GLYPH_PERCENT};
+    int stat_w = l->stats_bar_w / NUM_STATS;
+
+    for (int i = 0; i < NUM_STATS; i++) {
+        int x = l->stats_bar_x + i * stat_w + stat_w / 2;
+        int level = i == STAT_IO ? get_stat_level(snap.io_util, 0) :
+                    i == STAT_NET ? rtt_level(snap.net_rtt) :
+                    get_stat_level(stat_values[i], i == STAT_TEMP);
+
+        /* Label at top */
+        SDL_Texture *label = i == STAT_TEMP && snap.throttled ? l->throttled_label : l->stat_labels[i];
+        blit_texture_centered(l, label, x, l->stats_bar_y + scale_px(l, 15));
+
+        /* Value in middle - Python uses +40 from stats_bar_y */
+        int glyphs[12];
+        int n = format_value_glyphs(stat_values[i], stat_units[i], glyphs);
+        draw_glyph_run_centered(l, &l->value_atlas[level], glyphs, n,
+                                x, l->stats_bar_y + scale_px(l, 55));  /* Adjusted for centered text */
+
+        /* Icon at bottom */
+        int icon = GLYPH_ICON_CPU + i;
+        draw_glyph_run_centered(l, &l->stat_icon_atlas[level], &icon, 1,
+                                x, l->stats_bar_y + scale_px(l, 90));
+
+        /* Last few minutes underneath */
+        draw_sparkline(l, i, x, l->stats_bar_y + scale_px(l, 112));
+    }
+}
+
+static void draw_idle(Launcher *l);
+
+static void draw(Launcher *l) {
+    if (l->idle != IDLE_NONE) {
+        draw_idle(l);
+        return;
+    }
+
+    /* Without a back buffer nothing persists between frames */
+    Uint32 dirty = l->frame ? l->dirty : REGION_ALL;
+    l->dirty = 0;
+    Uint64 cpu_start = profile_now(CLOCK_THREAD_CPUTIME_ID);
+    if (!dirty) return;
+
+    /* Recomposite only the union of invalidated regions */
+    SDL_Rect clip = {0, 0, 0, 0};
+    for (int i = 0; i < NUM_REGIONS; i++) {
+        if (i == REGION_MODAL || !(dirty & REGION_BIT(i))) continue;
+        if (SDL_RectEmpty(&clip)) {
+            clip = l->regions[i];
+        } else {
+            SDL_UnionRect(&clip, &l->regions[i], &clip);
+        }
+    }
+
+    /* An empty clip means only the dialog changed - the back buffer is still current */
+    if (!SDL_RectEmpty(&clip)) {
+        if (l->frame) SDL_SetRenderTarget(l->renderer, l->frame);
+        SDL_RenderSetClipRect(l->renderer, &clip);
+
+        /* Background */
+        SDL_RenderCopy(l->renderer, l->background, NULL, NULL);
+
+        /* Everything overlapping the clip is redrawn, in z-order */
+        if (SDL_HasIntersection(&clip, &l->regions[REGION_CLOCK])) draw_clock(l);
+        if (SDL_HasIntersection(&clip, &l->regions[REGION_SETTINGS])) draw_settings(l);
+        for (int i = 0; i < MAX_VISIBLE_TILES; i++) {
+            if (slot_app(l, i) < 0) continue;
+            if (SDL_HasIntersection(&clip, &l->regions[REGION_TILE_FIRST + i])) draw_tile(l, i);
+        }
+        SDL_Rect highlight = highlight_rect(l);
+        if (SDL_HasIntersection(&clip, &highlight)) {
+            /* Fades out as settings takes the selection */
+            render_copy_alpha(l, l->tile_border_selected, &highlight,
+                              1.0f - selection_amount(l, SEL_SETTINGS));
+        }
+        if (SDL_HasIntersection(&clip, &l->regions[REGION_STATS])) draw_stats_bar(l);
+
+        /* Help icon in bottom-right - Python uses width - 40, height - 40 with centered text */
+        blit_texture_centered(l, l->help_text, l->width - scale_px(l, 40), l->height - scale_px(l, 40));
+
+        SDL_RenderSetClipRect(l->renderer, NULL);
+        if (l->frame) SDL_SetRenderTarget(l->renderer, NULL);
+    }
+    if (l->frame) SDL_RenderCopy(l->renderer, l->frame, NULL, NULL);
+
+    if (l->modal != MODAL_NONE) draw_modal(l);
+
+    Uint64 cpu_ns = profile_elapsed(CLOCK_THREAD_CPUTIME_ID, cpu_start);
+    Uint64 present_start = profile_now(CLOCK_MONOTONIC);
+    SDL_RenderPresent(l->renderer);
+    profile_draw(cpu_ns, profile_elapsed(CLOCK_MONOTONIC, present_start));
+}
+
+/* ============ App Warming ============ */
+
+/*
+ * Cold starts on a Pi are dominated by reading the app's binaries and
+ * libraries off the SD card. For apps marked warm the files they mapped on
+ * their last run are recorded, and while the launcher sits idle they are
+ * pulled back into the page cache with POSIX_FADV_WILLNEED.
+ */
+
+static int warm_list_path(char *buf, size_t size, const App *app) {
+    char dir[512];
+    if (!cache_dir(dir, sizeof(dir))) return 0;
+    Uint64 key = fnv1a(0xcbf29ce484222325ULL, app->command, strlen(app->command));
+    int n = snprintf(buf, size, "%s/warm-%016llx.list", dir, (unsigned long long)key);
+    return n > 0 && (size_t)n < size;
+}
+
+static void prefetch_file(const char *path) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return;
+    posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+    close(fd);
+}
+
+/* The executable posix_spawnp would run, plus its interpreter if it's a script */
+static void prefetch_executable(const App *app) {
+    if (!app->argv) return;
+
+    char path[512];
+    const char *name = app->argv[0];
+    if (strchr(name, '/')) {
+        snprintf(path, sizeof(path), "%s", name);
+    } else {
+        const char *env = getenv("PATH");
+        const char *dir = env ? env : "/usr/local/bin:/usr/bin:/bin";
+        path[0] = '\0';
+        while (*dir) {
+            size_t len = strcspn(dir, ":");
+            int n = snprintf(path, sizeof(path), "%.*s/%s", (int)len, dir, name);
+            if (n > 0 && (size_t)n < sizeof(path) && access(path, X_OK) == 0) break;
+            path[0] = '\0';
+            dir += len;
+            if (*dir == ':') dir++;
+        }
+        if (!path[0]) return;
+    }
+    prefetch_file(path);
+
+    char head[256];
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return;
+    ssize_t n = pread(fd, head, sizeof(head) - 1, 0);
+    close(fd);
+    if (n > 2 && head[0] == '#' && head[1] == '!') {
+        head[n] = '\0';
+        char *interp = head + 2;
+        while (*interp == ' ') interp++;
+        interp[strcspn(interp, " \t\r\n")] = '\0';
+        if (*interp) prefetch_file(interp);
+    }
+}
+
+static void *warm_thread_func(void *arg) {
+    Launcher *l = (Launcher *)arg;
+    Warmer *w = &l->warmer;
+    char path[600];
+    char line[1024];
+
+    for (int i = 0; i < l->catalog.num_apps && !atomic_load(&w->stop); i++) {
+        const App *app = &l->catalog.apps[i];
+        if (!app->warm) continue;
+
+        prefetch_executable(app);
+        if (!warm_list_path(path, sizeof(path), app)) continue;
+        FILE *f = fopen(path, "re");
+        if (!f) continue;
+        while (!atomic_load(&w->stop) && fgets(line, sizeof(line), f)) {
+            line[strcspn(line, "\n")] = '\0';
+            if (line[0] == '/') prefetch_file(line);
+        }
+        fclose(f);
+    }
+
+    atomic_store(&w->done, 1);
+    return NULL;
+}
+
+static Uint32 warm_timer_func(Uint32 interval, void *arg) {
+    (void)interval;
+    post_wake((Launcher *)arg, WAKE_WARM, NULL);
+    return 0;
+}
+
+/* Prefetch once the launcher has been idle for WARM_DELAY_MS */
+static void warm_schedule(Launcher *l) {
+    Warmer *w = &l->warmer;
+    int any = 0;
+    for (int i = 0; i < l->catalog.num_apps; i++) any |= l->catalog.apps[i].warm;
+    if (!any) return;
+
+    if (w->timer) SDL_RemoveTimer(w->timer);
+    w->timer = SDL_AddTimer(WARM_DELAY_MS, warm_timer_func, l);
+}
+
+static void warm_start(Launcher *l) {
+    Warmer *w = &l->warmer;
+    w->timer = 0;
+    if (l->app_running) return;
+
+    /* A previous pass still reading keeps going; a finished one is reaped first */
+    if (w->started) {
+        if (!atomic_load(&w->done)) return;
+        pthread_join(w->thread, NULL);
+        w->started = 0;
+    }
+
+    atomic_store(&w->stop, 0);
+    atomic_store(&w->done, 0);
+    if (pthread_create(&w->thread, NULL, warm_thread_func, l) == 0) w->started = 1;
+}
+
+/* Launching: don't compete with the app for the disk */
+static void warm_cancel(Launcher *l) {
+    Warmer *w = &l->warmer;
+    if (w->timer) SDL_RemoveTimer(w->timer);
+    w->timer = 0;
+    atomic_store(&w->stop, 1);
+}
+
+static void warm_stop(Launcher *l) {
+    Warmer *w = &l->warmer;
+    warm_cancel(l);
+    if (w->snapshot_timer) SDL_RemoveTimer(w->snapshot_timer);
+    w->snapshot_timer = 0;
+    if (w->started) {
+        pthread_join(w->thread, NULL);
+        w->started = 0;
+    }
+}
+
+static Uint32 warm_snapshot_timer_func(Uint32 interval, void *arg) {
+    (void)interval;
+    Launcher *l = (Launcher *)arg;
+    post_wake(l, WAKE_WARM_SNAPSHOT, (void *)(intptr_t)l->warmer.snapshot_pid);
+    return 0;
+}
+
+/* Record the files mapped by a freshly launched warm app once it has settled */
+static void warm_arm_snapshot(Launcher *l, const App *app, pid_t pid) {
+    Warmer *w = &l->warmer;
+    if (!app->warm || !warm_list_path(w->snapshot_path, sizeof(w->snapshot_path), app)) return;
+
+    if (w->snapshot_timer) SDL_RemoveTimer(w->snapshot_timer);
+    w->snapshot_pid = pid;
+    w->snapshot_timer = SDL_AddTimer(WARM_SNAPSHOT_MS, warm_snapshot_timer_func, l);
+}
+
+/* Write every file mapped anywhere in the process tree under root to the list */
+static void warm_snapshot(Launcher *l, pid_t root) {
+    Warmer *w = &l->warmer;
+    pid_t procs[MAX_WARM_PROCS];
+    int nprocs = 0;
+    char path[64];
+    char line[1024];
+
+    w->snapshot_timer = 0;
+
+    /* Breadth-first - launch wrappers usually fork the real app */
+    procs[nprocs++] = root;
+    for (int i = 0; i < nprocs; i++) {
+        snprintf(path, sizeof(path), "/proc/%d/task/%d/children", (int)procs[i], (int)procs[i]);
+        FILE *f = fopen(path, "re");
+        if (!f) continue;
+        int child;
+        while (nprocs < MAX_WARM_PROCS && fscanf(f, "%d", &child) == 1) procs[nprocs++] = child;
+        fclose(f);
+    }
+
+    char tmp[640];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", w->snapshot_path);
+    FILE *out = fopen(tmp, "we");
+    if (!out) return;
+
+    char **seen = calloc(MAX_WARM_FILES, sizeof(char *));
+    int nseen = 0;
+    for (int i = 0; seen && i < nprocs; i++) {
+        snprintf(path, sizeof(path), "/proc/%d/maps", (int)procs[i]);
+        FILE *f = fopen(path, "re");
+        if (!f) continue;
+        while (nseen < MAX_WARM_FILES && fgets(line, sizeof(line), f)) {
+            char *file = strchr(line, '/');
+            if (!file) continue;
+            file[strcspn(file, "\n")] = '\0';
+            if (strstr(file, " (deleted)")) continue;
+
+            int dup = 0;
+            for (int k = nseen - 1; k >= 0 && !dup; k--) dup = strcmp(seen[k], file) == 0;
+            if (dup || !(seen[nseen] = strdup(file))) continue;
+            fprintf(out, "%s\n", seen[nseen++]);
+        }
+        fclose(f);
+    }
+    for (int i = 0; i < nseen; i++) free(seen[i]);
+    free(seen);
+
+    if (fclose(out) == 0 && nseen > 0) {
+        rename(tmp, w->snapshot_path);
+    } else {
+        unlink(tmp);
+    }
+}
+
+/* ============ App Launch ============ */
+
+/* Track launched app PID */
+static pid_t launched_app_pid = 0;
+
+static int pidfd_open_compat(pid_t pid) {
+    return (int)syscall(SYS_pidfd_open, pid, 0);
+}
+
+/* Reap the watched child if it has exited, waking the main loop */
+static void supervisor_reap(Launcher *l) {
+    ChildSupervisor *cs = &l->supervisor;
+
+    pthread_mutex_lock(&cs->lock);
+    pid_t pid = cs->pid;
+    int status;
+    pid_t r = pid > 0 ? waitpid(pid, &status, WNOHANG) : 0;
+    int exited = (r == pid && pid > 0) || (r < 0 && errno == ECHILD);
+    if (exited) {
+        cs->pid = 0;
+        if (cs->pid_fd >= 0) close(cs->pid_fd);
+        cs->pid_fd = -1;
+    }
+    pthread_mutex_unlock(&cs->lock);
+
+    if (exited) post_wake(l, WAKE_CHILD_EXIT, (void *)(intptr_t)pid);
+}
+
+/* Sleeps in poll() until the watched child exits - no timeout, no polling */
+static void *supervisor_thread_func(void *arg) {
+    Launcher *l = (Launcher *)arg;
+    ChildSupervisor *cs = &l->supervisor;
+
+    while (1) {
+        struct pollfd fds[2];
+        int nfds = 0;
+
+        pthread_mutex_lock(&cs->lock);
+        if (!cs->running) {
+            pthread_mutex_unlock(&cs->lock);
+            break;
+        }
+        int child_fd = cs->sig_fd >= 0 ? cs->sig_fd : cs->pid_fd;
+        pthread_mutex_unlock(&cs->lock);
+
+        fds[nfds++] = (struct pollfd){cs->wake_fd, POLLIN, 0};
+        if (child_fd >= 0) fds[nfds++] = (struct pollfd){child_fd, POLLIN, 0};
+
+        if (poll(fds, nfds, -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            uint64_t v;
+            if (read(cs->wake_fd, &v, sizeof(v)) < 0) {}
+        }
+
+        /* Drain queued SIGCHLDs - the exit itself is confirmed by waitpid */
+        if (cs->sig_fd >= 0 && nfds > 1 && (fds[1].revents & POLLIN)) {
+            struct signalfd_siginfo si[8];
+            while (read(cs->sig_fd, si, sizeof(si)) > 0) {}
+        }
+
+        /* A child may have exited before it was handed to us, so always check */
+        supervisor_reap(l);
+    }
+    return NULL;
+}
+
+static void supervisor_wake(ChildSupervisor *cs) {
+    uint64_t one = 1;
+    if (write(cs->wake_fd, &one, sizeof(one)) < 0) {}
+}
+
+static int supervisor_start(Launcher *l) {
+    ChildSupervisor *cs = &l->supervisor;
+
+    pthread_mutex_init(&cs->lock, NULL);
+    cs->pid = 0;
+    cs->pid_fd = -1;
+    cs->sig_fd = -1;
+    cs->wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (cs->wake_fd < 0) return 0;
+
+    /* pidfd_open needs Linux 5.3 - fall back to a signalfd on SIGCHLD (blocked in main) */
+    int probe = pidfd_open_compat(getpid());
+    if (probe >= 0) {
+        close(probe);
+    } else {
+        sigset_t mask;
+        sigemptyset(&mask);
+        sigaddset(&mask, SIGCHLD);
+        cs->sig_fd = signalfd(-1, &mask, SFD_CLOEXEC | SFD_NONBLOCK);
+        if (cs->sig_fd < 0) {
+            close(cs->wake_fd);
+            cs->wake_fd = -1;
+            return 0;
+        }
+    }
+
+    cs->running = 1;
+    if (pthread_create(&cs->thread, NULL, supervisor_thread_func, l) != 0) {
+        cs->running = 0;
+        if (cs->sig_fd >= 0) close(cs->sig_fd);
+        close(cs->wake_fd);
+        cs->sig_fd = cs->wake_fd = -1;
+        return 0;
+    }
+    return 1;
+}
+
+static void supervisor_stop(Launcher *l) {
+    ChildSupervisor *cs = &l->supervisor;
+    if (!cs->running) return;
+
+    pthread_mutex_lock(&cs->lock);
+    cs->running = 0;
+    pthread_mutex_unlock(&cs->lock);
+    supervisor_wake(cs);
+    pthread_join(cs->thread, NULL);
+
+    if (cs->pid_fd >= 0) close(cs->pid_fd);
+    if (cs->sig_fd >= 0) close(cs->sig_fd);
+    close(cs->wake_fd);
+    pthread_mutex_destroy(&cs->lock);
+}
+
+/* Hand a freshly forked child to the supervisor - returns 0 if it can't be watched */
+static int supervisor_watch(Launcher *l, pid_t pid) {
+    ChildSupervisor *cs = &l->supervisor;
+    if (!cs->running) return 0;
+
+    pthread_mutex_lock(&cs->lock);
+    /* One app at a time - the previous one would go unreaped */
+    if (cs->pid > 0) {
+        pthread_mutex_unlock(&cs->lock);
+        return 0;
+    }
+    if (cs->pid_fd >= 0) close(cs->pid_fd);
+    cs->pid = pid;
+    /* Our unreaped child can't be recycled, so opening the pidfd after fork is safe */
+    cs->pid_fd = cs->sig_fd >= 0 ? -1 : pidfd_open_compat(pid);
+    int ok = cs->sig_fd >= 0 || cs->pid_fd >= 0;
+    if (!ok) cs->pid = 0;
+    pthread_mutex_unlock(&cs->lock);
+
+    supervisor_wake(cs);
+    return ok;
+}
+
+extern char **environ;
+
+static const App settings_app = {
+    "Settings", "gnome-control-center", ICON_SETTINGS, 0,
+    (char *const[]){"gnome-control-center", NULL}
+};
+
+/*
+ * posix_spawn (vfork-style in glibc, no page table copy) straight into the
+ * pre-split argv, falling back to /bin/sh -c for commands that need a shell.
+ * Returns the pid, or -1 with errno set.
+ */
+static pid_t spawn_app(const App *app) {
+    posix_spawnattr_t attr;
+    sigset_t empty;
+    pid_t pid;
+    int err;
+
+    if ((err = posix_spawnattr_init(&attr)) != 0) {
+        errno = err;
+        return -1;
+    }
+
+    /* Child shouldn't inherit the blocked SIGCHLD, and gets its own session */
+    short flags = POSIX_SPAWN_SETSIGMASK;
+    sigemptyset(&empty);
+    posix_spawnattr_setsigmask(&attr, &empty);
+#ifdef POSIX_SPAWN_SETSID
+    flags |= POSIX_SPAWN_SETSID;
+#else
+    flags |= POSIX_SPAWN_SETPGROUP;
+#endif
+    posix_spawnattr_setflags(&attr, flags);
+
+    if (app->argv) {
+        err = posix_spawnp(&pid, app->argv[0], NULL, &attr, app->argv, environ);
+    } else {
+        char *const sh_argv[] = {"sh", "-c", (char *)app->command, NULL};
+        err = posix_spawn(&pid, "/bin/sh", NULL, &attr, sh_argv, environ);
+    }
+    posix_spawnattr_destroy(&attr);
+
+    if (err) {
+        errno = err;
+        return -1;
+    }
+    return pid;
+}
+
+/*
+ * system() for configured commands: the shell would otherwise inherit the
+ * blocked SIGCHLD. Waits for it - the supervisor only reaps the app it
+ * watches. Returns the exit status, -1 if it didn't run or was killed.
+ */
+static int run_command(const char *command) {
+    App cmd = {.name = command, .command = command};
+    pid_t pid = spawn_app(&cmd);
+    if (pid < 0) return -1;
+
+    int status;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) return -1;
+    }
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+/* Returns 1 if the app was started */
+static int launch_app(Launcher *l, const App *app) {
+    warm_cancel(l);
+
+    pid_t pid = spawn_app(app);
+    if (pid < 0) {
+        fprintf(stderr, "Failed to launch %s: %s\n", app->name, strerror(errno));
+        return 0;
+    }
+
+    /* Parent: store PID and don't wait - let app run in foreground */
+    launched_app_pid = pid;
+
+    if (!supervisor_watch(l, pid)) {
+        /* Without a watcher the exit would go unnoticed - stop it and keep the launcher visible */
+        fprintf(stderr, "Failed to watch launched app\n");
+        kill(pid, SIGKILL);
+        waitpid(pid, NULL, 0);
+        launched_app_pid = 0;
+        return 0;
+    }
+
+    warm_arm_snapshot(l, app, pid);
+    return 1;
+}
+
+/* ============ Memory Trim ============ */
+
+static void drop_texture(SDL_Texture **tex) {
+    if (*tex) SDL_DestroyTexture(*tex);
+    *tex = NULL;
+}
+
+/* Persistent back buffer - redraws only recomposite dirty regions into it */
+static void create_frame(Launcher *l) {
+    l->frame = SDL_CreateTexture(l->renderer, SDL_PIXELFORMAT_RGBA8888,
+                                 SDL_TEXTUREACCESS_TARGET, l->width, l->height);
+    if (l->frame) SDL_SetTextureBlendMode(l->frame, SDL_BLENDMODE_NONE);
+}
+
+/* Every GPU texture the scene owns - rebuilt by the startup path */
+static void release_scene(Launcher *l) {
+    drop_texture(&l->frame);
+    drop_texture(&l->background);
+    drop_texture(&l->tile_bg_normal);
+    drop_texture(&l->tile_bg_selected);
+    drop_texture(&l->stats_bar_bg);
+    drop_texture(&l->sparklines);
+    drop_texture(&l->settings_bg_normal);
+    drop_texture(&l->settings_bg_selected);
+    drop_texture(&l->settings_ring);
+    drop_texture(&l->tile_border_normal);
+    drop_texture(&l->tile_border_selected);
+
+    for (int i = 0; i < MAX_VISIBLE_TILES; i++) {
+        tile_textures_release(&l->tile_tex[i]);
+    }
+
+    for (int i = 0; i < NUM_STATS; i++) {
+        drop_texture(&l->stat_labels[i]);
+    }
+    drop_texture(&l->throttled_label);
+
+    drop_texture(&l->settings_icon);
+    drop_texture(&l->settings_icon_dim);
+    drop_texture(&l->help_text);
+    for (int m = 0; m < NUM_MODALS; m++) {
+        drop_texture(&l->dialogs[m]);
+    }
+    drop_texture(&l->date_text);
+
+    destroy_glyph_atlas(&l->clock_atlas);
+    for (int i = 0; i < NUM_LEVELS; i++) {
+        destroy_glyph_atlas(&l->value_atlas[i]);
+        destroy_glyph_atlas(&l->stat_icon_atlas[i]);
+    }
+}
+
+/* Close every face - the startup worker reopens them when it finds none open */
+static void release_fonts(Launcher *l) {
+    font_registry_close(&l->fonts);
+    l->font_clock = l->font_date = l->font_tile = NULL;
+    l->font_stat_value = l->font_stat_label = NULL;
+    l->font_icon = l->font_icon_small = NULL;
+}
+
+/*
+ * While an app has the screen, hand back everything that can be rebuilt:
+ * all textures, the fonts, and the heap pages they leave behind. The
+ * window and renderer stay, so resuming is the staged startup again with
+ * the wallpaper coming straight from its on-disk cache.
+ */
+static void launcher_suspend(Launcher *l) {
+    bg_refresh_discard(&l->bg_refresh);
+    l->ready = 0;
+    l->suspended = 1;
+    release_scene(l);
+
+#if TRIM_FONTS
+    release_fonts(l);
+#endif
+
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+}
+
+/* The window is shown again from startup_finish() once everything is uploaded */
+static int launcher_resume(Launcher *l) {
+    memset(&l->startup, 0, sizeof(l->startup));
+    if (!startup_begin(l)) {
+        startup_thread_func(l);
+        return startup_finish(l);
+    }
+    return 1;
+}
+
+/* ============ Resize ============ */
+
+/*
+ * Everything rasterized depends only on the display scale, so a new size
+ * at the same scale just needs the screen-sized textures and the layout.
+ * A new scale reopens the fonts and rebuilds the scene through the staged
+ * startup, with the window left up.
+ */
+static int launcher_resize(Launcher *l, int width, int height) {
+    if (width == l->width && height == l->height) return 1;
+
+    /* The worker reads the size and scale - wait for it to finish */
+    if (l->startup.started) {
+        l->resize_pending = 1;
+        return 1;
+    }
+
+    float scale = layout_scale(width, height);
+    int rescale = scale != l->scale;
+    l->width = width;
+    l->height = height;
+    l->scale = scale;
+
+    /* Suspended - the scene is rebuilt for the new size on resume anyway */
+    if (!l->ready) {
+        if (rescale) release_fonts(l);
+        return 1;
+    }
+
+    if (rescale) {
+        bg_refresh_discard(&l->bg_refresh);
+        l->ready = 0;
+        release_scene(l);
+        release_fonts(l);
+        return launcher_resume(l);
+    }
+
+    /* The old wallpaper is stretched until the worker has one at the new size */
+    drop_texture(&l->frame);
+    if (!l->bg_refresh.started && !bg_refresh_start(l)) {
+        drop_texture(&l->background);
+        bg_prepare(&l->startup.bg, width, height);
+        l->background = load_background(l, &l->startup.bg);
+    }
+    create_frame(l);
+
+    calc_layout(l);
+    scroll_to_selection(l);
+    tiles_sync(l);
+    anim_reset(l);
+    invalidate(l, REGION_ALL);
+    return 1;
+}
+
+/* Swap in the refreshed wallpaper, or prepare another if the size moved on meanwhile */
+static void bg_refresh_finish(Launcher *l) {
+    BackgroundRefresh *r = &l->bg_refresh;
+    if (!r->started) return;
+
+    pthread_join(r->thread, NULL);
+    r->started = 0;
+    atomic_store(&r->lost_wake, 0);
+    if (r->width != l->width || r->height != l->height) {
+        bg_release(&r->bg);
+        bg_refresh_start(l);
+        return;
+    }
+
+    drop_texture(&l->background);
+    l->background = load_background(l, &r->bg);
+    invalidate(l, REGION_ALL);
+}
+
+/* ============ Control Socket ============ */
+
+/*
+ * A Unix stream socket taking one command per line, so a phone app, a
+ * CEC bridge or a shell script can drive the launcher without faking
+ * key events. The I/O thread only frames lines; each one is handed to
+ * the main loop as a WAKE_CONTROL event and answered from there, so
+ * commands never race the scene.
+ */
+
+#define CONTROL_LISTEN  MAX_CONTROL_CLIENTS         /* epoll tags past the client slots */
+#define CONTROL_STOP    (MAX_CONTROL_CLIENTS + 1)
+
+static int control_enabled = 1;     /* 0 under --bench - it must not take the real socket */
+
+/* $XDG_RUNTIME_DIR/tvstreamer.sock, falling back to a per-user name in /tmp */
+static int control_path(char *buf, size_t size) {
+    const char *run = getenv("XDG_RUNTIME_DIR");
+    int n = run && *run ? snprintf(buf, size, "%s/tvstreamer.sock", run)
+                        : snprintf(buf, size, "/tmp/tvstreamer-%u.sock", (unsigned)getuid());
+    return n > 0 && (size_t)n < size;
+}
+
+/* Best effort - replies are a line, well within an empty socket buffer */
+static void control_reply(int fd, const char *text) {
+    if (send(fd, text, strlen(text), MSG_NOSIGNAL | MSG_DONTWAIT) < 0) {}
+}
+
+static void control_drop(ControlServer *cs, int slot) {
+    ControlClient *c = &cs->clients[slot];
+    epoll_ctl(cs->epoll_fd, EPOLL_CTL_DEL, c->fd, NULL);
+    close(c->fd);
+    c->fd = -1;
+    c->len = 0;
+}
+
+static void control_accept(ControlServer *cs) {
+    int fd;
+    while ((fd = accept(cs->listen_fd, NULL, NULL)) >= 0) {
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+        fcntl(fd, F_SETFL, O_NONBLOCK);
+
+        int slot = -1;
+        for (int i = 0; i < MAX_CONTROL_CLIENTS && slot < 0; i++) {
+            if (cs->clients[i].fd < 0) slot = i;
+        }
+
+        struct epoll_event ev = {.events = EPOLLIN, .data.u32 = (uint32_t)slot};
+        if (slot < 0 || epoll_ctl(cs->epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            control_reply(fd, "error busy\n");
+            close(fd);
+            continue;
+        }
+        cs->clients[slot].fd = fd;
+        cs->clients[slot].len = 0;
+    }
+}
+
+/* Queue a complete line for the main thread - the reply goes out through a dup of the socket */
+static void control_post(Launcher *l, int fd, const char *line) {
+    ControlCommand *cmd = malloc(sizeof(*cmd));
+    if (!cmd) return;
+
+    snprintf(cmd->line, sizeof(cmd->line), "%s", line);
+    cmd->fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    if (cmd->fd < 0 || !post_wake(l, WAKE_CONTROL, cmd)) {
+        control_reply(fd, "error busy\n");
+        if (cmd->fd >= 0) close(cmd->fd);
+        free(cmd);
+    }
+}
+
+/* A command that will never be executed - still answered, and its dup closed */
+static void control_discard(SDL_UserEvent *e) {
+    ControlCommand *cmd = e->data1;
+    control_reply(cmd->fd, "error shutting down\n");
+    close(cmd->fd);
+    free(cmd);
+}
+
+/* Answer whatever commands are still queued once nothing will run them */
+static void control_flush(Launcher *l) {
+    SDL_Event e;
+    if (l->wake_event == (Uint32)-1) return;
+    while (SDL_PeepEvents(&e, 1, SDL_GETEVENT, l->wake_event, l->wake_event) > 0) {
+        if (e.user.code == WAKE_CONTROL) control_discard(&e.user);
+    }
+}
+
+/* Read what's there and post every complete line. Returns 0 once the client is gone */
+static int control_read(Launcher *l, ControlClient *c) {
+    while (1) {
+        ssize_t n = read(c->fd, c->buf + c->len, sizeof(c->buf) - 1 - c->len);
+        if (n == 0) return 0;
+        if (n < 0) return errno == EAGAIN || errno == EINTR;
+        c->len += (int)n;
+
+        char *start = c->buf, *nl;
+        while ((nl = memchr(start, '\n', (size_t)(c->buf + c->len - start)))) {
+            *nl = '\0';
+            char *line = trim(start);
+            if (*line) control_post(l, c->fd, line);
+            start = nl + 1;
+        }
+        c->len -= (int)(start - c->buf);
+        memmove(c->buf, start, (size_t)c->len);
+
+        if (c->len == (int)sizeof(c->buf) - 1) {
+            control_reply(c->fd, "error line too long\n");
+            return 0;
+        }
+    }
+}
 
-    /* Tile backgrounds */
-    l->tile_bg_normal = create_rounded_rect_texture(l, TILE_WIDTH, TILE_HEIGHT, TILE_RADIUS,
-                                                     COL_BG_TILE);
-    l->tile_bg_selected = create_rounded_rect_texture(l, TILE_WIDTH, TILE_HEIGHT, TILE_RADIUS,
-                                                       COL_BG_TILE_SEL);
+/* Sleeps in epoll_wait() until a client connects, sends a line or hangs up */
+static void *control_thread_func(void *arg) {
+    Launcher *l = (Launcher *)arg;
+    ControlServer *cs = &l->control;
+    struct epoll_event events[MAX_CONTROL_CLIENTS + 2];
 
-    /* Settings backgrounds */
-    l->settings_bg_normal = create_rounded_rect_texture(l, 50, 50, 25, 0x1A, 0x1E, 0x33, 0x96);
-    l->settings_bg_selected = create_rounded_rect_texture(l, 56, 56, 28, 0x2D, 0x34, 0x50, 0xC8);
+    while (1) {
+        int n = epoll_wait(cs->epoll_fd, events, MAX_CONTROL_CLIENTS + 2, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
 
-    /* Stats bar background - more visible */
-    l->stats_bar_w = 580;  /* Python: 580 */
-    l->stats_bar_h = 120;  /* Python: 120 */
-    l->stats_bar_bg = create_rounded_rect_texture(l, l->stats_bar_w, l->stats_bar_h, 20,
-                                                   0x1A, 0x1E, 0x33, 0xC8);  /* radius=20, alpha=200 like Python */
+        for (int i = 0; i < n; i++) {
+            uint32_t tag = events[i].data.u32;
+            if (tag == CONTROL_STOP) return NULL;
+            if (tag == CONTROL_LISTEN) {
+                control_accept(cs);
+            } else if (!control_read(l, &cs->clients[tag]) || (events[i].events & (EPOLLHUP | EPOLLERR))) {
+                control_drop(cs, (int)tag);
+            }
+        }
+    }
+    return NULL;
+}
+
+/* Bind the socket, unless another launcher is already answering on it */
+static int control_listen(ControlServer *cs) {
+    struct sockaddr_un addr = {.sun_family = AF_UNIX};
+    if (!control_path(cs->path, sizeof(cs->path))) return -1;
+    memcpy(addr.sun_path, cs->path, sizeof(cs->path));
 
-    /* Tile labels and icons */
-    for (int i = 0; i < NUM_APPS; i++) {
-        l->tile_labels[i] = render_text(l, l->font_tile, apps[i].name, fg);
-        l->tile_icons[i] = render_text(l, l->font_icon, apps[i].icon, fg);
-        l->tile_icons_dim[i] = render_text(l, l->font_icon, apps[i].icon, fg_dim);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+
+    /* A socket file nobody accepts on is left over from a crash */
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0 || errno == EAGAIN) {
+        fprintf(stderr, "Warning: %s is in use by another launcher\n", cs->path);
+        close(fd);
+        return -1;
+    }
+    close(fd);
+    unlink(cs->path);
+
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || chmod(cs->path, 0600) < 0 ||
+        listen(fd, MAX_CONTROL_CLIENTS) < 0) {
+        fprintf(stderr, "Warning: can't listen on %s: %s\n", cs->path, strerror(errno));
+        close(fd);
+        return -1;
     }
+    return fd;
+}
 
-    /* Settings icon */
-    l->settings_icon = render_text(l, l->font_icon, ICON_SETTINGS, fg);
-    l->settings_icon_dim = render_text(l, l->font_icon, ICON_SETTINGS, fg_dim);
+static int control_start(Launcher *l) {
+    ControlServer *cs = &l->control;
+    if (l->wake_event == (Uint32)-1) return 0;
 
-    /* Stat labels */
-    const char *stat_names[] = {"CPU", "RAM", "TEMP", "DISK"};
-    const char *stat_icons[] = {ICON_CPU, ICON_MEMORY, ICON_TEMP, ICON_DISK};
-    for (int i = 0; i < 4; i++) {
-        l->stat_labels[i] = render_text(l, l->font_stat_label, stat_names[i], fg_dim);
-        l->stat_icons[i] = render_text(l, l->font_icon_small, stat_icons[i], fg);
+    for (int i = 0; i < MAX_CONTROL_CLIENTS; i++) cs->clients[i].fd = -1;
+    cs->listen_fd = control_listen(cs);
+    if (cs->listen_fd < 0) return 0;
+
+    cs->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    cs->stop_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    struct epoll_event listen_ev = {.events = EPOLLIN, .data.u32 = CONTROL_LISTEN};
+    struct epoll_event stop_ev = {.events = EPOLLIN, .data.u32 = CONTROL_STOP};
+
+    if (cs->epoll_fd >= 0 && cs->stop_fd >= 0 &&
+        epoll_ctl(cs->epoll_fd, EPOLL_CTL_ADD, cs->listen_fd, &listen_ev) == 0 &&
+        epoll_ctl(cs->epoll_fd, EPOLL_CTL_ADD, cs->stop_fd, &stop_ev) == 0 &&
+        pthread_create(&cs->thread, NULL, control_thread_func, l) == 0) {
+        cs->started = 1;
+        return 1;
     }
 
-    /* Help text */
-    l->help_text = render_text(l, l->font_tile, "?", fg_dim);
+    if (cs->epoll_fd >= 0) close(cs->epoll_fd);
+    if (cs->stop_fd >= 0) close(cs->stop_fd);
+    close(cs->listen_fd);
+    unlink(cs->path);
+    return 0;
 }
 
-/* ============ Layout Calculation ============ */
+static void control_stop(Launcher *l) {
+    ControlServer *cs = &l->control;
+    if (!cs->started) return;
 
-static void calc_layout(Launcher *l) {
-    int total_w = NUM_APPS * TILE_WIDTH + (NUM_APPS - 1) * TILE_SPACING;
-    int grid_x = (l->width - total_w) / 2;
-    int grid_y = (int)(l->height * 0.48);
+    uint64_t one = 1;
+    if (write(cs->stop_fd, &one, sizeof(one)) < 0) {}
+    pthread_join(cs->thread, NULL);
+    cs->started = 0;
+    control_flush(l);
+
+    for (int i = 0; i < MAX_CONTROL_CLIENTS; i++) {
+        if (cs->clients[i].fd >= 0) close(cs->clients[i].fd);
+    }
+    close(cs->listen_fd);
+    close(cs->epoll_fd);
+    close(cs->stop_fd);
+    unlink(cs->path);
+}
+
+/* ============ Remote Input ============ */
+
+/*
+ * TV remotes read straight from evdev: IR receivers, Bluetooth remotes
+ * and HDMI-CEC adapters, whose kernel driver exposes the TV remote's
+ * passthrough keys as an input device. This skips the keymapping daemon
+ * and SDL's own device polling - a press is in the event queue as soon
+ * as the kernel reports it. Devices are grabbed so nothing else sees a
+ * key twice, and released whenever an app is in front. Keys we don't map
+ * (volume, mute, power, Home) would vanish with the grab, so a remote
+ * that has any is given a uinput twin re-emitting just those; without
+ * /dev/uinput, or with --no-remote-grab, it is left to SDL.
+ */
+
+#define REMOTE_DELAY_MS     300     /* hold time before the first repeat */
+#define REMOTE_REPEAT_MS    140     /* first repeat interval... */
+#define REMOTE_REPEAT_MIN   40      /* ...shrinking to this the longer it's held */
+#define REMOTE_ACCEL_MS     15      /* interval shortened per repeat */
+
+static int remote_grab = 1;     /* 0 with --no-remote-grab - remotes stay with SDL */
+
+#define REMOTE_NOTIFY   MAX_REMOTES             /* epoll tags past the device slots */
+#define REMOTE_TIMER    (MAX_REMOTES + 1)
+#define REMOTE_WAKE     (MAX_REMOTES + 2)
+
+static const struct {
+    Uint16 code;
+    SDL_Keycode sym;
+    int repeats;
+} remote_keys[] = {
+    {KEY_UP, SDLK_UP, 1},
+    {KEY_DOWN, SDLK_DOWN, 1},
+    {KEY_LEFT, SDLK_LEFT, 1},
+    {KEY_RIGHT, SDLK_RIGHT, 1},
+    {KEY_ENTER, SDLK_RETURN, 0},
+    {KEY_KPENTER, SDLK_RETURN, 0},
+    {KEY_OK, SDLK_RETURN, 0},
+    {KEY_SELECT, SDLK_RETURN, 0},
+    /* Back on a remote closes a dialog - it never quits the launcher */
+    {KEY_BACK, SDLK_AC_BACK, 0},
+    {KEY_EXIT, SDLK_AC_BACK, 0},
+    {KEY_ESC, SDLK_AC_BACK, 0},
+};
 
-    for (int i = 0; i < NUM_APPS; i++) {
-        l->tile_rects[i].x = grid_x + i * (TILE_WIDTH + TILE_SPACING);
-        l->tile_rects[i].y = grid_y;
-        l->tile_rects[i].w = TILE_WIDTH;
-        l->tile_rects[i].h = TILE_HEIGHT;
+#define NUM_REMOTE_KEYS ((int)(sizeof(remote_keys) / sizeof(remote_keys[0])))
+
+static int remote_bit(const unsigned long *bits, int bit) {
+    return (bits[bit / (8 * sizeof(long))] >> (bit % (8 * sizeof(long)))) & 1;
+}
+
+static int remote_mapped(int code) {
+    for (int k = 0; k < NUM_REMOTE_KEYS; k++) {
+        if (remote_keys[k].code == code) return 1;
     }
+    return 0;
+}
 
-    l->stats_bar_x = (l->width - l->stats_bar_w) / 2;
-    /* Use larger margin for TV overscan - 120px from bottom */
-    l->stats_bar_y = l->height - l->stats_bar_h - 120;
+/* Arrows plus OK, and not a full keyboard - SDL already handles those */
+static int remote_is_remote(const unsigned long *keys) {
+    return remote_bit(keys, KEY_UP) && remote_bit(keys, KEY_DOWN) &&
+           remote_bit(keys, KEY_LEFT) && remote_bit(keys, KEY_RIGHT) &&
+           (remote_bit(keys, KEY_OK) || remote_bit(keys, KEY_SELECT) || remote_bit(keys, KEY_ENTER)) &&
+           !remote_bit(keys, KEY_Q);
+}
+
+/* A virtual device with only the remote's unmapped keys - it isn't a remote itself */
+static int remote_passthrough(int fd, const unsigned long *keys) {
+    int ufd = open("/dev/uinput", O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+    if (ufd < 0) return -1;
+
+    int ok = ioctl(ufd, UI_SET_EVBIT, EV_KEY) == 0 && ioctl(ufd, UI_SET_EVBIT, EV_SYN) == 0;
+    for (int code = 0; ok && code < KEY_CNT; code++) {
+        if (remote_bit(keys, code) && !remote_mapped(code)) ok = ioctl(ufd, UI_SET_KEYBIT, code) == 0;
+    }
+
+    struct uinput_setup setup;
+    memset(&setup, 0, sizeof(setup));
+    setup.id.bustype = BUS_VIRTUAL;
+    char name[UINPUT_MAX_NAME_SIZE - 16] = "remote";
+    if (ioctl(fd, EVIOCGNAME(sizeof(name)), name) < 0) {}
+    name[sizeof(name) - 1] = '\0';
+    snprintf(setup.name, sizeof(setup.name), "%s passthrough", name);
+
+    if (!ok || ioctl(ufd, UI_DEV_SETUP, &setup) < 0 || ioctl(ufd, UI_DEV_CREATE) < 0) {
+        close(ufd);
+        return -1;
+    }
+    return ufd;
+}
+
+/*
+ * 1 if the device is ours to grab, with *passthrough_fd set when some of
+ * its keys must be forwarded. Pointer remotes are left alone - their
+ * motion would be lost.
+ */
+static int remote_claim(int fd, int *passthrough_fd) {
+    unsigned long keys[KEY_CNT / (8 * sizeof(long)) + 1];
+    unsigned long types[EV_CNT / (8 * sizeof(long)) + 1];
+    memset(keys, 0, sizeof(keys));
+    memset(types, 0, sizeof(types));
+    *passthrough_fd = -1;
+    if (ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keys)), keys) < 0 ||
+        ioctl(fd, EVIOCGBIT(0, sizeof(types)), types) < 0) return 0;
+    if (!remote_is_remote(keys) || remote_bit(types, EV_REL) || remote_bit(types, EV_ABS)) return 0;
+
+    for (int code = 0; code < KEY_CNT; code++) {
+        if (remote_bit(keys, code) && !remote_mapped(code)) {
+            *passthrough_fd = remote_passthrough(fd, keys);
+            return *passthrough_fd >= 0;
+        }
+    }
+    return 1;
+}
+
+static void remote_close(RemoteInput *ri, int slot) {
+    RemoteDevice *d = &ri->devices[slot];
+    epoll_ctl(ri->epoll_fd, EPOLL_CTL_DEL, d->fd, NULL);
+    ioctl(d->fd, EVIOCGRAB, 0);
+    close(d->fd);
+    if (d->passthrough_fd >= 0) {
+        ioctl(d->passthrough_fd, UI_DEV_DESTROY);
+        close(d->passthrough_fd);
+    }
+    d->fd = -1;
+    d->passthrough_fd = -1;
+    d->node[0] = '\0';
+}
+
+static void remote_open(RemoteInput *ri, int dir_fd, const char *node) {
+    size_t len = strlen(node);
+    if (len >= sizeof(ri->devices[0].node)) return;
+
+    int slot = -1;
+    for (int i = 0; i < MAX_REMOTES; i++) {
+        if (ri->devices[i].fd >= 0 && strcmp(ri->devices[i].node, node) == 0) return;
+        if (ri->devices[i].fd < 0 && slot < 0) slot = i;
+    }
+    if (slot < 0) return;
+
+    int fd = openat(dir_fd, node, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) return;
+
+    struct epoll_event ev = {.events = EPOLLIN, .data.u32 = (uint32_t)slot};
+    int passthrough_fd;
+    if (!remote_claim(fd, &passthrough_fd)) {
+        close(fd);
+        return;
+    }
+    if (ioctl(fd, EVIOCGRAB, 1) < 0 || epoll_ctl(ri->epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        if (passthrough_fd >= 0) {
+            ioctl(passthrough_fd, UI_DEV_DESTROY);
+            close(passthrough_fd);
+        }
+        close(fd);
+        return;
+    }
+    ri->devices[slot].fd = fd;
+    ri->devices[slot].passthrough_fd = passthrough_fd;
+    memcpy(ri->devices[slot].node, node, len + 1);
+}
+
+static void remote_scan(RemoteInput *ri) {
+    DIR *dir = opendir("/dev/input");
+    if (!dir) return;
+
+    struct dirent *de;
+    while ((de = readdir(dir))) {
+        if (strncmp(de->d_name, "event", 5) == 0) remote_open(ri, dirfd(dir), de->d_name);
+    }
+    closedir(dir);
+}
+
+static void remote_arm(RemoteInput *ri, int ms) {
+    struct itimerspec its = {.it_value = {ms / 1000, (long)(ms % 1000) * 1000000}};
+    timerfd_settime(ri->timer_fd, 0, &its, NULL);
+}
+
+/* A keydown as SDL would have delivered it, so handle_event() treats both alike */
+static void remote_post(SDL_Keycode sym, int repeat) {
+    SDL_Event e;
+    memset(&e, 0, sizeof(e));
+    e.type = SDL_KEYDOWN;
+    e.key.timestamp = SDL_GetTicks();
+    e.key.state = SDL_PRESSED;
+    e.key.repeat = (Uint8)repeat;
+    e.key.keysym.sym = sym;
+    SDL_PushEvent(&e);
+}
+
+/* Kernel autorepeat is dropped - repeats come from our own accelerating timer */
+static void remote_key(RemoteInput *ri, const struct input_event *ev) {
+    int k = 0;
+    while (k < NUM_REMOTE_KEYS && remote_keys[k].code != ev->code) k++;
+    if (k == NUM_REMOTE_KEYS || ev->value == 2) return;
+
+    if (ev->value == 0) {
+        if (ri->held == k) {
+            ri->held = -1;
+            remote_arm(ri, 0);
+        }
+        return;
+    }
+
+    remote_post(remote_keys[k].sym, 0);
+    ri->held = remote_keys[k].repeats ? k : -1;
+    ri->repeats = 0;
+    remote_arm(ri, ri->held >= 0 ? REMOTE_DELAY_MS : 0);
+}
+
+static void remote_repeat(RemoteInput *ri) {
+    uint64_t expirations;
+    if (read(ri->timer_fd, &expirations, sizeof(expirations)) < 0 || ri->held < 0) return;
+
+    remote_post(remote_keys[ri->held].sym, 1);
+    ri->repeats++;
+    int interval = REMOTE_REPEAT_MS - ri->repeats * REMOTE_ACCEL_MS;
+    remote_arm(ri, interval > REMOTE_REPEAT_MIN ? interval : REMOTE_REPEAT_MIN);
+}
+
+/* Unmapped keys go out on the twin, each with its own report so nothing is held back */
+static void remote_forward(int passthrough_fd, const struct input_event *ev) {
+    struct input_event out[2];
+    memset(out, 0, sizeof(out));
+    out[0].type = EV_KEY;
+    out[0].code = ev->code;
+    out[0].value = ev->value;
+    out[1].type = EV_SYN;
+    out[1].code = SYN_REPORT;
+    if (write(passthrough_fd, out, sizeof(out)) < 0) {}
+}
+
+/* Drain a device. Returns 0 once it's gone */
+static int remote_read(RemoteInput *ri, int slot) {
+    RemoteDevice *d = &ri->devices[slot];
+    struct input_event evs[16];
+    ssize_t n;
+    while ((n = read(d->fd, evs, sizeof(evs))) > 0) {
+        for (int i = 0; i < n / (ssize_t)sizeof(evs[0]); i++) {
+            if (evs[i].type != EV_KEY) continue;
+            if (remote_mapped(evs[i].code)) {
+                remote_key(ri, &evs[i]);
+            } else if (d->passthrough_fd >= 0) {
+                remote_forward(d->passthrough_fd, &evs[i]);
+            }
+        }
+    }
+    return n < 0 && errno == EAGAIN;
+}
+
+/* Open devices while active, none otherwise - an app gets its remote back */
+static void remote_apply(RemoteInput *ri) {
+    uint64_t v;
+    if (read(ri->wake_fd, &v, sizeof(v)) < 0) {}
+
+    if (atomic_load(&ri->active)) {
+        remote_scan(ri);
+        return;
+    }
+    for (int i = 0; i < MAX_REMOTES; i++) {
+        if (ri->devices[i].fd >= 0) remote_close(ri, i);
+    }
+    ri->held = -1;
+    remote_arm(ri, 0);
+}
+
+/* Sleeps in epoll_wait() until a key, a repeat, a hotplugged device or a state change */
+static void *remote_thread_func(void *arg) {
+    RemoteInput *ri = (RemoteInput *)arg;
+    struct epoll_event events[MAX_REMOTES + 3];
+    char notify[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+    remote_scan(ri);
+    while (!atomic_load(&ri->stop)) {
+        int n = epoll_wait(ri->epoll_fd, events, MAX_REMOTES + 3, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        for (int i = 0; i < n; i++) {
+            uint32_t tag = events[i].data.u32;
+            if (tag == REMOTE_WAKE) {
+                remote_apply(ri);
+            } else if (tag == REMOTE_TIMER) {
+                remote_repeat(ri);
+            } else if (tag == REMOTE_NOTIFY) {
+                /* Nodes appear before udev fixes their permissions, so rescan on either */
+                while (read(ri->notify_fd, notify, sizeof(notify)) > 0) {}
+                if (atomic_load(&ri->active)) remote_scan(ri);
+            } else if (ri->devices[tag].fd >= 0 && !remote_read(ri, (int)tag)) {
+                if (ri->held >= 0) remote_arm(ri, 0);
+                ri->held = -1;
+                remote_close(ri, (int)tag);
+            }
+        }
+    }
+    return NULL;
+}
+
+static int remote_start(Launcher *l) {
+    RemoteInput *ri = &l->remote;
+
+    for (int i = 0; i < MAX_REMOTES; i++) {
+        ri->devices[i].fd = -1;
+        ri->devices[i].passthrough_fd = -1;
+    }
+    ri->held = -1;
+    atomic_store(&ri->active, 1);
+    ri->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    ri->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    ri->wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    ri->notify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    struct epoll_event timer_ev = {.events = EPOLLIN, .data.u32 = REMOTE_TIMER};
+    struct epoll_event wake_ev = {.events = EPOLLIN, .data.u32 = REMOTE_WAKE};
+    struct epoll_event notify_ev = {.events = EPOLLIN, .data.u32 = REMOTE_NOTIFY};
+
+    if (ri->epoll_fd >= 0 && ri->timer_fd >= 0 && ri->wake_fd >= 0 &&
+        epoll_ctl(ri->epoll_fd, EPOLL_CTL_ADD, ri->timer_fd, &timer_ev) == 0 &&
+        epoll_ctl(ri->epoll_fd, EPOLL_CTL_ADD, ri->wake_fd, &wake_ev) == 0) {
+        /* Without hotplug only the remotes present at startup are used */
+        if (ri->notify_fd >= 0 &&
+            (inotify_add_watch(ri->notify_fd, "/dev/input", IN_CREATE | IN_ATTRIB) < 0 ||
+             epoll_ctl(ri->epoll_fd, EPOLL_CTL_ADD, ri->notify_fd, &notify_ev) < 0)) {
+            close(ri->notify_fd);
+            ri->notify_fd = -1;
+        }
+        if (pthread_create(&ri->thread, NULL, remote_thread_func, ri) == 0) {
+            ri->started = 1;
+            return 1;
+        }
+    }
+
+    if (ri->epoll_fd >= 0) close(ri->epoll_fd);
+    if (ri->timer_fd >= 0) close(ri->timer_fd);
+    if (ri->wake_fd >= 0) close(ri->wake_fd);
+    if (ri->notify_fd >= 0) close(ri->notify_fd);
+    return 0;
+}
+
+static void remote_wake(RemoteInput *ri) {
+    uint64_t one = 1;
+    if (write(ri->wake_fd, &one, sizeof(one)) < 0) {}
+}
+
+/* Grab the remotes while the launcher has the screen, release them for an app */
+static void remote_set_active(Launcher *l, int active) {
+    RemoteInput *ri = &l->remote;
+    if (!ri->started || atomic_exchange(&ri->active, active) == active) return;
+    remote_wake(ri);
+}
+
+static void remote_stop(Launcher *l) {
+    RemoteInput *ri = &l->remote;
+    if (!ri->started) return;
+
+    atomic_store(&ri->stop, 1);
+    remote_wake(ri);
+    pthread_join(ri->thread, NULL);
+    ri->started = 0;
+
+    for (int i = 0; i < MAX_REMOTES; i++) {
+        if (ri->devices[i].fd >= 0) remote_close(ri, i);
+    }
+    close(ri->epoll_fd);
+    close(ri->timer_fd);
+    close(ri->wake_fd);
+    if (ri->notify_fd >= 0) close(ri->notify_fd);
+}
+
+/* ============ Idle Mode ============ */
+
+/*
+ * With no input for a while the launcher drops to a dimmed clock on
+ * black, moved a little every minute so nothing static burns into an
+ * OLED, and stops sampling stats. Optionally the display is blanked
+ * later on. Every texture stays resident, so the first key just
+ * repaints the full scene - it is swallowed rather than acted on.
+ */
+
+#define IDLE_DEFAULT_MIN    10      /* minutes without input before dimming */
+#define IDLE_CLOCK_ALPHA    70      /* dimmed clock opacity */
+#define IDLE_MARGIN         0.1f    /* of the screen the clock keeps clear of the edges */
+#define IDLE_MAX_MIN        (7 * 24 * 60)   /* --idle/--blank beyond a week is clamped */
+
+static Uint32 idle_dim_ms = IDLE_DEFAULT_MIN * 60000;   /* 0 = never, --idle */
+static Uint32 idle_blank_ms = 0;                        /* after dimming, 0 = never, --blank */
+
+/* Minutes from the command line to ms, negative or garbage as 0 */
+static Uint32 idle_parse_minutes(const char *arg) {
+    long min = strtol(arg, NULL, 10);
+    if (min < 0) min = 0;
+    if (min > IDLE_MAX_MIN) min = IDLE_MAX_MIN;
+    return (Uint32)min * 60000u;
+}
+
+static Uint32 idle_timer_func(Uint32 interval, void *arg) {
+    (void)interval;
+    post_wake((Launcher *)arg, WAKE_IDLE, NULL);
+    return 0;
+}
+
+static void idle_arm(Launcher *l, Uint32 ms) {
+    if (l->idle_timer) SDL_RemoveTimer(l->idle_timer);
+    l->idle_timer = SDL_AddTimer(ms, idle_timer_func, l);
+}
+
+/* Line 1 of blank.conf turns the display off, line 2 back on - e.g. xset dpms force off / on */
+static void idle_display_power(int on) {
+    char path[512], line[512];
+    if (!config_path(path, sizeof(path), "blank.conf")) return;
+    FILE *f = fopen(path, "r");
+    if (!f) return;
+
+    int n = 0;
+    while (fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\n")] = '\0';
+        char *cmd = trim(line);
+        if (*cmd == '\0' || *cmd == '#') continue;
+        if (n++ == (on ? 1 : 0)) {
+            if (run_command(cmd) != 0) fprintf(stderr, "Warning: '%s' failed\n", cmd);
+            break;
+        }
+    }
+    fclose(f);
+}
+
+/* The idle timer fired - dim or blank if there really was no input since it was armed */
+static void idle_check(Launcher *l) {
+    l->idle_timer = 0;
+    /* Re-armed from startup_finish() once the launcher is back on screen */
+    if (!idle_dim_ms || !l->ready || l->app_running) return;
+
+    if (l->idle == IDLE_NONE) {
+        Uint32 quiet = SDL_GetTicks() - l->last_input;
+        if (quiet < idle_dim_ms) {
+            idle_arm(l, idle_dim_ms - quiet);
+            return;
+        }
+        l->idle = IDLE_DIM;
+        stats_set_paused(l, 1);
+        if (l->modal != MODAL_NONE) l->modal = MODAL_NONE;
+        if (idle_blank_ms) idle_arm(l, idle_blank_ms);
+    } else if (l->idle == IDLE_DIM) {
+        l->idle = IDLE_BLANK;
+        SDL_EnableScreenSaver();
+        idle_display_power(0);
+    }
+    invalidate(l, REGION_ALL);
+}
+
+/* Note input. Returns 1 if it woke the launcher from idle, and should go no further */
+static int idle_input(Launcher *l) {
+    l->last_input = SDL_GetTicks();
+    if (l->idle == IDLE_NONE) {
+        if (!l->idle_timer && idle_dim_ms) idle_arm(l, idle_dim_ms);
+        return 0;
+    }
+
+    if (l->idle == IDLE_BLANK) {
+        idle_display_power(1);
+        SDL_DisableScreenSaver();
+    }
+    l->idle = IDLE_NONE;
+    stats_set_paused(l, 0);
+    invalidate(l, REGION_ALL);
+    if (idle_dim_ms) idle_arm(l, idle_dim_ms);
+    return 1;
+}
+
+/* Dimmed clock straight to the screen - the back buffer keeps the full scene's textures */
+static void draw_idle(Launcher *l) {
+    Uint32 dirty = l->dirty;
+    l->dirty = 0;
+    SDL_SetRenderDrawColor(l->renderer, 0, 0, 0, 255);
+    if (l->idle == IDLE_BLANK) {
+        /* One black frame, then nothing until input */
+        if (!(dirty & REGION_BIT(REGION_BACKGROUND))) return;
+        SDL_RenderClear(l->renderer);
+        SDL_RenderPresent(l->renderer);
+        return;
+    }
+
+    /* Clock text and position only change with the minute - other regions don't show */
+    time_t now = time(NULL);
+    if (!(dirty & REGION_BIT(REGION_BACKGROUND)) && now / 60 == l->idle_minute) return;
+    l->idle_minute = now / 60;
+
+    struct tm *t = localtime(&now);
+    int glyphs[5] = {t->tm_hour / 10, t->tm_hour % 10, GLYPH_COLON, t->tm_min / 10, t->tm_min % 10};
+    int w = glyph_run_width(&l->clock_atlas, glyphs, 5);
+    int h = l->clock_atlas.height;
+
+    /* A different spot every minute, scattered by a cheap hash of the minute */
+    Uint32 minute = (Uint32)(now / 60) * 2654435761u;
+    int margin_x = (int)(l->width * IDLE_MARGIN), margin_y = (int)(l->height * IDLE_MARGIN);
+    int range_x = l->width - w - 2 * margin_x, range_y = l->height - h - 2 * margin_y;
+    int x = margin_x + (range_x > 0 ? (int)((minute >> 8) % (Uint32)range_x) : 0);
+    int y = margin_y + (range_y > 0 ? (int)((minute >> 20) % (Uint32)range_y) : 0);
+
+    SDL_RenderClear(l->renderer);
+    if (l->clock_atlas.texture) {
+        SDL_SetTextureAlphaMod(l->clock_atlas.texture, IDLE_CLOCK_ALPHA);
+        draw_glyph_run(l, &l->clock_atlas, glyphs, 5, x, y);
+        SDL_SetTextureAlphaMod(l->clock_atlas.texture, 255);
+    }
+    SDL_RenderPresent(l->renderer);
+}
+
+/* ============ Display Backend ============ */
+
+/*
+ * Windowed runs as a borderless window under whatever X11 or Wayland
+ * session is up. KMSDRM drives the display directly with GLES2, for boots
+ * straight into the launcher with no compositor at all. There only one
+ * process can be DRM master, so the whole video subsystem is shut down
+ * before an app is spawned and brought back up when it exits.
+ */
+
+enum {
+    BACKEND_AUTO,
+    BACKEND_WINDOWED,
+    BACKEND_KMSDRM,
+    NUM_BACKENDS
+};
+
+static const char *const backend_names[NUM_BACKENDS] = {"auto", "windowed", "kmsdrm"};
+
+static int display_backend = BACKEND_AUTO;  /* --backend, resolved by backend_select() */
+
+static int backend_parse(const char *name) {
+    for (int i = 0; i < NUM_BACKENDS; i++) {
+        if (strcmp(name, backend_names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+/* Before SDL_Init: auto means KMSDRM when there's no session to open a window in */
+static int backend_select(int backend) {
+    if (backend == BACKEND_AUTO) {
+        const char *driver = getenv("SDL_VIDEODRIVER");
+        int session = getenv("WAYLAND_DISPLAY") || getenv("DISPLAY");
+        backend = driver ? (strcmp(driver, "kmsdrm") == 0 ? BACKEND_KMSDRM : BACKEND_WINDOWED)
+                : session || access("/dev/dri/card0", F_OK) != 0 ? BACKEND_WINDOWED : BACKEND_KMSDRM;
+    }
+
+    if (backend == BACKEND_KMSDRM) {
+        setenv("SDL_VIDEODRIVER", "kmsdrm", 1);
+        setenv("SDL_RENDER_DRIVER", "opengles2", 0);
+    }
+    return backend;
+}
+
+/* Window and renderer at the display's size. Returns 0 with the error printed */
+static int video_open(Launcher *l, int shown) {
+    SDL_DisplayMode dm;
+    if (SDL_GetCurrentDisplayMode(0, &dm) == 0) {
+        l->width = dm.w;
+        l->height = dm.h;
+    } else {
+        l->width = 1920;
+        l->height = 1080;
+    }
+
+    /* Borderless for better compositor compatibility; on KMSDRM the current mode, no modeset */
+    Uint32 flags = l->backend == BACKEND_KMSDRM ? SDL_WINDOW_FULLSCREEN_DESKTOP : SDL_WINDOW_BORDERLESS;
+    flags |= shown ? SDL_WINDOW_SHOWN : SDL_WINDOW_HIDDEN;
+    l->window = SDL_CreateWindow("TvStreamer", 0, 0, l->width, l->height, flags);
+    if (!l->window) {
+        fprintf(stderr, "SDL_CreateWindow failed: %s\n", SDL_GetError());
+        return 0;
+    }
+
+    /* Get actual window size after creation */
+    SDL_GetWindowSize(l->window, &l->width, &l->height);
+    l->scale = layout_scale(l->width, l->height);
+
+    /* Create renderer with VSync */
+    l->renderer = SDL_CreateRenderer(l->window, -1,
+                                      SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    if (!l->renderer) {
+        /* Try software renderer as fallback */
+        l->renderer = SDL_CreateRenderer(l->window, -1, SDL_RENDERER_SOFTWARE);
+    }
+    if (!l->renderer) {
+        fprintf(stderr, "SDL_CreateRenderer failed: %s\n", SDL_GetError());
+        return 0;
+    }
+
+    SDL_SetRenderDrawBlendMode(l->renderer, SDL_BLENDMODE_BLEND);
+    SDL_ShowCursor(SDL_DISABLE);
+    return 1;
+}
+
+static void video_close(Launcher *l) {
+    if (l->renderer) SDL_DestroyRenderer(l->renderer);
+    if (l->window) SDL_DestroyWindow(l->window);
+    l->renderer = NULL;
+    l->window = NULL;
+}
+
+/* Drop DRM master for the app - the scene must already be released, see launcher_suspend() */
+static void video_release(Launcher *l) {
+    if (l->backend != BACKEND_KMSDRM || l->video_released) return;
+    video_close(l);
+    /* Events and timers were initialized on their own, so wakes keep arriving */
+    SDL_QuitSubSystem(SDL_INIT_VIDEO);
+    l->video_released = 1;
+}
+
+/* Take the display back. The window stays hidden until startup_finish() has a scene */
+static int video_acquire(Launcher *l) {
+    if (!l->video_released) return 1;
+    if (SDL_InitSubSystem(SDL_INIT_VIDEO) < 0) {
+        fprintf(stderr, "SDL video reinit failed: %s\n", SDL_GetError());
+        l->failed = 1;
+        return 0;
+    }
+    l->video_released = 0;
+    if (!video_open(l, 0)) {
+        l->failed = 1;
+        return 0;
+    }
+    l->resize_pending = 0;
+    return 1;
+}
+
+/* ============ Event Handling ============ */
+
+/* Open a dialog, or close it with MODAL_NONE - only the overlay needs repainting */
+static void modal_set(Launcher *l, int modal) {
+    l->modal = modal;
+    invalidate(l, REGION_BIT(REGION_MODAL));
+}
+
+static void modal_key(Launcher *l, SDL_Keycode sym) {
+    int modal = l->modal;
+
+    if (sym == SDLK_RETURN || sym == SDLK_KP_ENTER) {
+        modal_set(l, MODAL_NONE);
+        const char *cmd = modal_actions[modal].command;
+        if (run_command(cmd) != 0) fprintf(stderr, "Warning: '%s' failed\n", cmd);
+    } else if (sym == SDLK_ESCAPE || sym == SDLK_AC_BACK) {
+        modal_set(l, MODAL_NONE);
+    }
+}
+
+static void update_clock(Launcher *l) {
+    time_t now = time(NULL);
+    struct tm *t = localtime(&now);
+    int current_minute = t->tm_hour * 60 + t->tm_min;
+    if (current_minute != l->last_minute) {
+        l->last_minute = current_minute;
+        invalidate(l, REGION_BIT(REGION_CLOCK));
+    }
+}
+
+/* Off screen with everything rebuildable released, and on KMSDRM the display too */
+static void launcher_hide(Launcher *l) {
+    if (l->window) SDL_HideWindow(l->window);
+    stats_set_paused(l, 1);
+    remote_set_active(l, 0);
+    if (!l->suspended) launcher_suspend(l);
+    video_release(l);
+}
+
+/* Back from an app or a remote suspend - startup_finish() shows the launcher again */
+static int launcher_wake(Launcher *l) {
+    if (!video_acquire(l)) return 0;
+    stats_set_paused(l, 0);
+    remote_set_active(l, 1);
+    if (!launcher_resume(l)) return 0;
+    /* The app may have pushed the warm set out of the page cache */
+    warm_schedule(l);
+    return 1;
+}
+
+/*
+ * Hide the launcher, mark the app as running and give its memory back.
+ * Returns 1 if it started, 0 if not, -1 if the launcher couldn't come back.
+ */
+static int launch_foreground(Launcher *l, const App *app) {
+    /* On KMSDRM the app can only open the display once we've let go of it */
+    int handoff = l->backend == BACKEND_KMSDRM;
+    if (handoff) launcher_hide(l);
+
+    if (!launch_app(l, app)) {
+        return handoff && !launcher_wake(l) ? -1 : 0;
+    }
+    l->app_running = 1;
+    if (!handoff) launcher_hide(l);
+    return 1;
 }
 
-/* ============ Drawing ============ */
+/* Catalog index from a number or a case-insensitive name, -1 if neither */
+static int control_find_app(Launcher *l, const char *arg) {
+    char *end;
+    long n = strtol(arg, &end, 10);
+    if (*arg && *end == '\0') return n >= 0 && n < l->catalog.num_apps ? (int)n : -1;
 
-static SDL_Color get_stat_color(int value, int is_temp) {
-    if (is_temp) {
-        if (value >= 70) return make_color(COL_RED);
-        if (value >= 55) return make_color(COL_ORANGE);
-        if (value >= 45) return make_color(COL_YELLOW);
-        return make_color(COL_GREEN);
-    } else {
-        if (value >= 80) return make_color(COL_RED);
-        if (value >= 60) return make_color(COL_YELLOW);
-        return make_color(COL_GREEN);
+    for (int i = 0; i < l->catalog.num_apps; i++) {
+        if (strcasecmp(l->catalog.apps[i].name, arg) == 0) return i;
     }
+    return -1;
 }
 
-static void draw(Launcher *l) {
-    /* Background */
-    SDL_RenderCopy(l->renderer, l->background, NULL, NULL);
+/* The startup worker is in flight - it owns the fonts and, the first time, the catalog */
+static int control_loading(Launcher *l) {
+    return l->startup.started || !l->catalog.apps;
+}
 
-    /* Clock */
-    time_t now = time(NULL);
-    struct tm *t = localtime(&now);
-    char buf[64];
+static void control_status(Launcher *l, char *buf, size_t size) {
+    StatsSample snap;
+    stats_snapshot(&l->stats.published, &snap);
 
-    snprintf(buf, sizeof(buf), "%02d:%02d", t->tm_hour, t->tm_min);
-    SDL_Color fg = make_color(COL_FG);
-    SDL_Texture *clock_tex = render_text(l, l->font_clock, buf, fg);
-    int clock_w, clock_h;
-    SDL_QueryTexture(clock_tex, NULL, NULL, &clock_w, &clock_h);
-    int clock_y = (int)(l->height * 0.12);
-    /* Python blits at top-left, so clock_y is top of text */
-    SDL_Rect clock_dst = {(l->width - clock_w) / 2, clock_y, clock_w, clock_h};
-    SDL_RenderCopy(l->renderer, clock_tex, NULL, &clock_dst);
-    SDL_DestroyTexture(clock_tex);
+    if (control_loading(l)) {
+        snprintf(buf, size, "ok state=loading\n");
+        return;
+    }
 
-    /* Date - positioned right below clock with 5px gap */
-    strftime(buf, sizeof(buf), "%A, %B %d", t);
-    SDL_Texture *date_tex = render_text(l, l->font_date, buf, fg);
-    int date_w, date_h;
-    SDL_QueryTexture(date_tex, NULL, NULL, &date_w, &date_h);
-    int date_y = clock_y + clock_h + 5;
-    SDL_Rect date_dst = {(l->width - date_w) / 2, date_y, date_w, date_h};
-    SDL_RenderCopy(l->renderer, date_tex, NULL, &date_dst);
-    SDL_DestroyTexture(date_tex);
+    static const char *const idle_states[] = {"idle", "dim", "blank"};
+    const char *state = l->app_running ? "app" : l->suspended ? "suspended"
+                      : l->ready ? idle_states[l->idle] : "loading";
+    const char *app = l->app_running ? "" : l->settings_selected ? settings_app.name
+                                          : l->catalog.apps[l->selected].name;
+    snprintf(buf, size, "ok state=%s selected=%d app=\"%s\" apps=%d cpu=%d mem=%d temp=%d disk=%d%s\n",
+             state, l->settings_selected ? -1 : l->selected, app, l->catalog.num_apps,
+             snap.cpu, snap.mem, snap.temp, snap.disk, snap.throttled ? " throttled" : "");
+}
 
-    /* Settings icon */
-    int settings_x = l->width - 60;
-    int settings_y = 50;
-    if (l->settings_selected) {
-        SDL_Rect dst = {settings_x - 28, settings_y - 28, 56, 56};
-        SDL_RenderCopy(l->renderer, l->settings_bg_selected, NULL, &dst);
-        /* Pink circle border */
-        SDL_SetRenderDrawColor(l->renderer, COL_PINK);
-        for (int r = 26; r <= 28; r++) {
-            for (int a = 0; a < 360; a++) {
-                int px = settings_x + (int)(r * cos(a * 3.14159 / 180));
-                int py = settings_y + (int)(r * sin(a * 3.14159 / 180));
-                SDL_RenderDrawPoint(l->renderer, px, py);
+/*
+ * One control socket line: "launch <app>", "select <app>", "warm",
+ * "suspend", "resume" or "status", where <app> is a catalog index or
+ * name. Returns 0 when the launcher should quit.
+ */
+static int control_execute(Launcher *l, ControlCommand *cmd) {
+    char reply[CONTROL_LINE_MAX + 64];
+    char *verb = cmd->line;
+    char *arg = verb + strcspn(verb, " \t");
+    if (*arg) *arg++ = '\0';
+    arg = trim(arg);
+
+    int hidden = l->suspended && !l->app_running && !l->startup.started;
+    snprintf(reply, sizeof(reply), "ok\n");
+
+    /* Anything but a status query counts as activity, and wakes the full scene first */
+    if (strcmp(verb, "status") != 0 && l->ready) idle_input(l);
+
+    if (strcmp(verb, "status") == 0) {
+        control_status(l, reply, sizeof(reply));
+    } else if (control_loading(l)) {
+        snprintf(reply, sizeof(reply), "error loading\n");
+    } else if (strcmp(verb, "launch") == 0 || strcmp(verb, "select") == 0) {
+        int app = control_find_app(l, arg);
+        if (app < 0) {
+            snprintf(reply, sizeof(reply), "error no app '%s'\n", arg);
+        } else if (l->app_running) {
+            snprintf(reply, sizeof(reply), "error app running\n");
+        } else {
+            Uint32 prev_selection = selection_region(l);
+            int prev_target = selection_target(l);
+            l->selected = app;
+            l->settings_selected = 0;
+            /* Hidden: startup_finish() lays out the new selection */
+            if (l->ready) {
+                scroll_to_selection(l);
+                invalidate(l, prev_selection | selection_region(l));
+                anim_select(l, prev_target);
             }
+            if (verb[0] == 'l') {
+                if (l->modal != MODAL_NONE) modal_set(l, MODAL_NONE);
+                int launched = launch_foreground(l, &l->catalog.apps[app]);
+                if (launched < 0) {
+                    control_reply(cmd->fd, "error launch failed\n");
+                    return 0;
+                } else if (!launched) {
+                    snprintf(reply, sizeof(reply), "error launch failed\n");
+                }
+            }
+        }
+    } else if (strcmp(verb, "warm") == 0) {
+        if (l->app_running) {
+            snprintf(reply, sizeof(reply), "error app running\n");
+        } else {
+            warm_start(l);
+        }
+    } else if (strcmp(verb, "suspend") == 0) {
+        /* Same as with an app in front, only nothing brings it back but "resume" */
+        if (!l->app_running && !l->suspended) launcher_hide(l);
+    } else if (strcmp(verb, "resume") == 0) {
+        if (hidden && !launcher_wake(l)) {
+            control_reply(cmd->fd, "error resume failed\n");
+            return 0;
         }
-        blit_texture_centered(l, l->settings_icon, settings_x, settings_y);
     } else {
-        SDL_Rect dst = {settings_x - 25, settings_y - 25, 50, 50};
-        SDL_RenderCopy(l->renderer, l->settings_bg_normal, NULL, &dst);
-        blit_texture_centered(l, l->settings_icon_dim, settings_x, settings_y);
+        snprintf(reply, sizeof(reply), "error unknown command '%s'\n", verb);
     }
 
-    /* Tiles */
-    for (int i = 0; i < NUM_APPS; i++) {
-        SDL_Rect *r = &l->tile_rects[i];
-        int is_sel = (i == l->selected) && !l->settings_selected;
+    control_reply(cmd->fd, reply);
+    return 1;
+}
 
-        /* Background */
-        SDL_RenderCopy(l->renderer, is_sel ? l->tile_bg_selected : l->tile_bg_normal, NULL, r);
+/* Returns 0 when the launcher should quit */
+static int handle_wake(Launcher *l, SDL_UserEvent *e) {
+    switch (e->code) {
+        case WAKE_STATS: {
+            StatsSample snap;
+            stats_snapshot(&l->stats.published, &snap);
+            history_push(l, &snap);
+            invalidate(l, REGION_BIT(REGION_STATS));
+            break;
+        }
 
-        /* Border */
-        if (is_sel) {
-            SDL_SetRenderDrawColor(l->renderer, COL_PINK);
-            for (int b = 0; b < 3; b++) {
-                SDL_Rect br = {r->x - b, r->y - b, r->w + 2*b, r->h + 2*b};
-                SDL_RenderDrawRect(l->renderer, &br);
+        case WAKE_CHILD_EXIT:
+            if ((pid_t)(intptr_t)e->data1 != launched_app_pid) break;
+            /* App closed - rebuild the scene, startup_finish() shows the launcher again */
+            launched_app_pid = 0;
+            l->app_running = 0;
+            if (!launcher_wake(l)) return 0;
+            break;
+
+        case WAKE_WARM:
+            warm_start(l);
+            break;
+
+        case WAKE_WARM_SNAPSHOT:
+            if ((pid_t)(intptr_t)e->data1 == launched_app_pid && l->app_running) {
+                warm_snapshot(l, launched_app_pid);
             }
-        } else {
-            SDL_SetRenderDrawColor(l->renderer, 0x42, 0x47, 0x61, 0x50);
-            SDL_RenderDrawRect(l->renderer, r);
+            break;
+
+        case WAKE_CLOCK:
+            update_clock(l);
+            break;
+
+        case WAKE_IDLE:
+            idle_check(l);
+            break;
+
+        case WAKE_STARTUP_DONE:
+            if (!startup_finish(l)) return 0;
+            break;
+
+        case WAKE_BACKGROUND:
+            bg_refresh_finish(l);
+            break;
+
+        case WAKE_CONTROL: {
+            ControlCommand *cmd = e->data1;
+            int ok = control_execute(l, cmd);
+            close(cmd->fd);
+            free(cmd);
+            if (!ok) return 0;
+            break;
         }
-
-        /* Icon */
-        int icon_y = r->y + r->h / 2 - 15;
-        blit_texture_centered(l, is_sel ? l->tile_icons[i] : l->tile_icons_dim[i],
-                             r->x + r->w / 2, icon_y);
-
-        /* Label - Python uses rect.bottom - 35 */
-        blit_texture_centered(l, l->tile_labels[i], r->x + r->w / 2, r->y + r->h - 35);
     }
+    return 1;
+}
 
-    /* Stats bar */
-    SDL_Rect stats_dst = {l->stats_bar_x, l->stats_bar_y, l->stats_bar_w, l->stats_bar_h};
-    SDL_RenderCopy(l->renderer, l->stats_bar_bg, NULL, &stats_dst);
-
-    int stat_values[] = {l->stats.cpu, l->stats.mem, l->stats.temp, l->stats.disk};
-    const char *stat_units[] = {"%", "%", "°C", "%"};
-    int stat_w = l->stats_bar_w / 4;
-
-    for (int i = 0; i < 4; i++) {
-        int x = l->stats_bar_x + i * stat_w + stat_w / 2;
-        SDL_Color col = get_stat_color(stat_values[i], i == 2);
-
-        /* Label at top */
-        blit_texture_centered(l, l->stat_labels[i], x, l->stats_bar_y + 15);
+/* Returns 0 when the launcher should quit */
+static int handle_event(Launcher *l, SDL_Event *e) {
+    profile_event(l->wake_event, e);
+    if (e->type == SDL_QUIT) {
+        return 0;
+    } else if (e->type == l->wake_event) {
+        return handle_wake(l, &e->user);
+    } else if (e->type == SDL_WINDOWEVENT && e->window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+        return launcher_resize(l, e->window.data1, e->window.data2);
+    } else if (e->type == SDL_RENDER_TARGETS_RESET) {
+        /* Back buffer contents were lost */
+        invalidate(l, REGION_ALL);
+    } else if (e->type == SDL_KEYDOWN && !l->ready) {
+        /* Still loading - only quitting does anything */
+        SDL_Keycode sym = e->key.keysym.sym;
+        return sym != SDLK_ESCAPE && sym != SDLK_q;
+    } else if (e->type == SDL_KEYDOWN) {
+        /* The key that ends idle mode only brings the scene back */
+        if (idle_input(l)) return 1;
+
+        /* Old and new selection both need repainting */
+        Uint32 prev_selection = selection_region(l);
+        int prev_target = selection_target(l);
+        int num_apps = l->catalog.num_apps;
+        stats_boost(l);
+
+        /* An open dialog takes all keys */
+        if (l->modal != MODAL_NONE) {
+            modal_key(l, e->key.keysym.sym);
+            return 1;
+        }
 
-        /* Value in middle - Python uses +40 from stats_bar_y */
-        snprintf(buf, sizeof(buf), "%d%s", stat_values[i], stat_units[i]);
-        SDL_Texture *val_tex = render_text(l, l->font_stat_value, buf, col);
-        blit_texture_centered(l, val_tex, x, l->stats_bar_y + 55);  /* Adjusted for centered text */
-        SDL_DestroyTexture(val_tex);
+        switch (e->key.keysym.sym) {
+            case SDLK_ESCAPE:
+            case SDLK_q:
+                return 0;
 
-        /* Icon at bottom */
-        SDL_Texture *icon_tex = render_text(l, l->font_icon_small,
-            (const char*[4]){ICON_CPU, ICON_MEMORY, ICON_TEMP, ICON_DISK}[i], col);
-        blit_texture_centered(l, icon_tex, x, l->stats_bar_y + 90);
-        SDL_DestroyTexture(icon_tex);
-    }
+            case SDLK_LEFT:
+                if (l->settings_selected) {
+                    l->settings_selected = 0;
+                } else {
+                    l->selected = (l->selected - 1 + num_apps) % num_apps;
+                }
+                break;
+
+            case SDLK_RIGHT:
+                if (l->settings_selected) {
+                    l->settings_selected = 0;
+                    l->selected = 0;
+                } else {
+                    l->selected = (l->selected + 1) % num_apps;
+                }
+                break;
 
-    /* Help icon in bottom-right - Python uses width - 40, height - 40 with centered text */
-    blit_texture_centered(l, l->help_text, l->width - 40, l->height - 40);
+            case SDLK_UP:
+                /* Up a row, and from the top row to the settings button */
+                if (l->settings_selected) {
+                    break;
+                } else if (l->selected >= l->grid_cols) {
+                    l->selected -= l->grid_cols;
+                } else {
+                    l->settings_selected = 1;
+                }
+                break;
+
+            case SDLK_DOWN:
+                if (l->settings_selected) {
+                    l->settings_selected = 0;
+                } else if (l->selected + l->grid_cols < num_apps) {
+                    l->selected += l->grid_cols;
+                } else if (l->selected / l->grid_cols < (num_apps - 1) / l->grid_cols) {
+                    /* Short last row - land on its last tile */
+                    l->selected = num_apps - 1;
+                }
+                break;
 
-    SDL_RenderPresent(l->renderer);
-}
+            case SDLK_RETURN:
+            case SDLK_KP_ENTER:
+                if (launch_foreground(l, l->settings_selected ? &settings_app
+                                                              : &l->catalog.apps[l->selected]) < 0) {
+                    return 0;
+                }
+                break;
 
-/* ============ App Launch ============ */
+            case SDLK_r:
+                modal_set(l, MODAL_REBOOT);
+                break;
 
-/* Track launched app PID */
-static pid_t launched_app_pid = 0;
+            case SDLK_p:
+                modal_set(l, MODAL_POWEROFF);
+                break;
+        }
 
-static void launch_app(const char *command) {
-    pid_t pid = fork();
-    if (pid == 0) {
-        /* Child process */
-        setsid();
-        execl("/bin/sh", "sh", "-c", command, NULL);
-        exit(1);
-    }
-    /* Parent: store PID and don't wait - let app run in foreground */
-    if (pid > 0) {
-        launched_app_pid = pid;
+        scroll_to_selection(l);
+        invalidate(l, prev_selection | selection_region(l));
+        anim_select(l, prev_target);
     }
+    return 1;
 }
 
-/* Check if launched app is still running */
-static int is_app_running(void) {
-    if (launched_app_pid <= 0) return 0;
+/* ============ Initialization ============ */
 
-    int status;
-    pid_t result = waitpid(launched_app_pid, &status, WNOHANG);
-    if (result == launched_app_pid) {
-        /* App has exited */
-        launched_app_pid = 0;
-        return 0;
-    } else if (result == 0) {
-        /* App still running */
-        return 1;
+/* Startup worker: fonts, wallpaper decode and text rasterization - no renderer calls */
+static void *startup_thread_func(void *arg) {
+    Launcher *l = (Launcher *)arg;
+    Startup *s = &l->startup;
+
+    /* Load fonts - one mapping per face, shared by all sizes. Kept across a suspend unless trimmed */
+    profile_begin(PHASE_FONTS);
+    if (l->fonts.num_open == 0) {
+        font_registry_open(&l->fonts);
+        l->font_clock = load_font(l, 180);
+        l->font_date = load_font(l, 42);
+        l->font_tile = load_font(l, 22);
+        l->font_stat_value = load_font(l, 36);
+        l->font_stat_label = load_font(l, 16);
+        l->font_icon = load_nerd_font(l, 42);
+        l->font_icon_small = load_nerd_font(l, 22);
+
+        if (l->font_tile && !l->font_icon) {
+            if (!l->suspended) {
+                fprintf(stderr, "Warning: Failed to load Nerd Font for icons, using fallback\n");
+            }
+            /* Use tile font as fallback for icons */
+            l->font_icon = l->font_tile;
+            l->font_icon_small = l->font_stat_label;
+        }
     }
-    /* Error - assume not running */
-    launched_app_pid = 0;
-    return 0;
-}
-
-/* ============ Confirmation Dialog ============ */
+    profile_end(PHASE_FONTS);
 
-static int show_confirm(Launcher *l, const char *action) {
-    /* Darken background */
-    SDL_SetRenderDrawBlendMode(l->renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(l->renderer, 0, 0, 0, 180);
-    SDL_Rect full = {0, 0, l->width, l->height};
-    SDL_RenderFillRect(l->renderer, &full);
-
-    /* Dialog */
-    int dw = 400, dh = 180;
-    int dx = (l->width - dw) / 2;
-    int dy = (l->height - dh) / 2;
+    profile_begin(PHASE_CATALOG);
+    int catalog_ok = l->catalog.apps || catalog_load(&l->catalog);
+    profile_end(PHASE_CATALOG);
 
-    SDL_Rect dialog = {dx, dy, dw, dh};
-    draw_rounded_rect(l->renderer, &dialog, 20, 0x1A, 0x1E, 0x33, 0xF0);
+    if (!l->font_clock) {
+        fprintf(stderr, "Failed to load clock font\n");
+        s->failed = 1;
+    } else if (!l->font_tile) {
+        fprintf(stderr, "Failed to load tile font\n");
+        s->failed = 1;
+    } else if (!catalog_ok) {
+        fprintf(stderr, "Failed to load app catalog\n");
+        s->failed = 1;
+    } else {
+        profile_begin(PHASE_BG_PREPARE);
+        bg_prepare(&s->bg, l->width, l->height);
+        profile_end(PHASE_BG_PREPARE);
 
-    /* Border */
-    SDL_SetRenderDrawColor(l->renderer, COL_ACCENT);
-    for (int b = 0; b < 2; b++) {
-        SDL_Rect br = {dx - b, dy - b, dw + 2*b, dh + 2*b};
-        SDL_RenderDrawRect(l->renderer, &br);
+        profile_begin(PHASE_RASTERIZE);
+        rasterize_surfaces(l, s);
+        profile_end(PHASE_RASTERIZE);
     }
 
-    /* Title */
-    char buf[64];
-    snprintf(buf, sizeof(buf), "%s?", action);
-    SDL_Color fg = make_color(COL_FG);
-    SDL_Texture *title = render_text(l, l->font_date, buf, fg);
-    blit_texture_centered(l, title, l->width / 2, dy + 60);
-    SDL_DestroyTexture(title);
-
-    /* Hint */
-    SDL_Color dim = make_color(COL_FG_DIM);
-    SDL_Texture *hint = render_text(l, l->font_tile, "Enter = Yes    Esc = No", dim);
-    blit_texture_centered(l, hint, l->width / 2, dy + 130);
-    SDL_DestroyTexture(hint);
-
-    SDL_RenderPresent(l->renderer);
-
-    /* Wait for input */
-    SDL_Event e;
-    while (1) {
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_KEYDOWN) {
-                if (e.key.keysym.sym == SDLK_RETURN || e.key.keysym.sym == SDLK_KP_ENTER) {
-                    return 1;
-                } else if (e.key.keysym.sym == SDLK_ESCAPE) {
-                    return 0;
-                }
-            }
-        }
-        SDL_Delay(50);
-    }
+    /* A full event queue would leave the main loop waiting forever - it polls for this instead */
+    if (!post_wake(l, WAKE_STARTUP_DONE, NULL)) atomic_store(&s->lost_wake, 1);
+    return NULL;
 }
 
-/* ============ Event Handling ============ */
-
-static int handle_events(Launcher *l) {
-    SDL_Event e;
+static int startup_begin(Launcher *l) {
+    Startup *s = &l->startup;
+    SDL_RendererInfo info;
 
-    while (SDL_PollEvent(&e)) {
-        if (e.type == SDL_QUIT) {
-            return 0;
-        } else if (e.type == SDL_KEYDOWN) {
-            l->needs_redraw = 1;
+    /* The worker needs to know up front whether the GPU can scale the wallpaper */
+    if (bg_renderer_caps(l->renderer, &s->bg, &info)) {
+        l->vsync = (info.flags & SDL_RENDERER_PRESENTVSYNC) != 0;
+    }
 
-            switch (e.key.keysym.sym) {
-                case SDLK_ESCAPE:
-                case SDLK_q:
-                    return 0;
+    /* Completion is signalled with a wake event, so both are needed */
+    if (l->wake_event == (Uint32)-1) return 0;
+    if (pthread_create(&s->thread, NULL, startup_thread_func, l) != 0) return 0;
+    s->started = 1;
+    return 1;
+}
 
-                case SDLK_LEFT:
-                    if (l->settings_selected) {
-                        l->settings_selected = 0;
-                    } else {
-                        l->selected = (l->selected - 1 + NUM_APPS) % NUM_APPS;
-                    }
-                    break;
+/* Render thread: collect the worker's output and do the GPU uploads. Returns 0 on failure */
+static int startup_finish(Launcher *l) {
+    Startup *s = &l->startup;
 
-                case SDLK_RIGHT:
-                    if (l->settings_selected) {
-                        l->settings_selected = 0;
-                        l->selected = 0;
-                    } else {
-                        l->selected = (l->selected + 1) % NUM_APPS;
-                    }
-                    break;
+    if (l->ready) return 1;
+    if (s->started) {
+        pthread_join(s->thread, NULL);
+        s->started = 0;
+    }
+    atomic_store(&s->lost_wake, 0);
+    if (s->failed) {
+        l->failed = 1;
+        return 0;
+    }
 
-                case SDLK_UP:
-                    if (!l->settings_selected) {
-                        l->settings_selected = 1;
-                    }
-                    break;
+    /* Load background */
+    profile_begin(PHASE_BG_UPLOAD);
+    l->background = load_background(l, &s->bg);
+    profile_end(PHASE_BG_UPLOAD);
 
-                case SDLK_DOWN:
-                    if (l->settings_selected) {
-                        l->settings_selected = 0;
-                    }
-                    break;
+    create_frame(l);
 
-                case SDLK_RETURN:
-                case SDLK_KP_ENTER:
-                    if (l->settings_selected) {
-                        launch_app("gnome-control-center");
-                    } else {
-                        launch_app(apps[l->selected].command);
-                    }
-                    /* Hide launcher and mark app as running */
-                    l->app_running = 1;
-                    SDL_HideWindow(l->window);
-                    break;
+    /* Cache surfaces */
+    profile_begin(PHASE_CACHE_SURFACES);
+    cache_surfaces(l, s);
+    profile_end(PHASE_CACHE_SURFACES);
 
-                case SDLK_r:
-                    if (show_confirm(l, "Reboot")) {
-                        system("sudo reboot");
-                    }
-                    l->needs_redraw = 1;
-                    break;
+    /* Calculate layout - needs the stats bar size and atlas metrics from the cache */
+    profile_begin(PHASE_LAYOUT);
+    calc_layout(l);
+    scroll_to_selection(l);
+    tiles_sync(l);
+    anim_reset(l);
+    profile_end(PHASE_LAYOUT);
+
+    l->ready = 1;
+    profile_ready();
+    invalidate(l, REGION_ALL);
+    warm_schedule(l);
+    idle_input(l);
+
+    /* Back from a suspend - the window was kept hidden until there is a scene to show */
+    if (l->suspended) {
+        l->suspended = 0;
+        SDL_ShowWindow(l->window);
+        SDL_RaiseWindow(l->window);
+    }
 
-                case SDLK_p:
-                    if (show_confirm(l, "Power Off")) {
-                        system("sudo poweroff");
-                    }
-                    l->needs_redraw = 1;
-                    break;
-            }
-        }
+    /* The window changed size while the worker was rasterizing for the old one */
+    if (l->resize_pending) {
+        int w, h;
+        l->resize_pending = 0;
+        SDL_GetWindowSize(l->window, &w, &h);
+        return launcher_resize(l, w, h);
     }
     return 1;
 }
 
-/* ============ Initialization ============ */
+/* Drop startup output that never got uploaded */
+static void startup_discard(Startup *s) {
+    if (s->started) {
+        pthread_join(s->thread, NULL);
+        s->started = 0;
+    }
+    for (int i = 0; i < s->num_uploads; i++) {
+        SDL_FreeSurface(s->uploads[i].surface);
+    }
+    s->num_uploads = 0;
+    bg_release(&s->bg);
+}
 
 static Launcher *launcher_create(void) {
     Launcher *l = calloc(1, sizeof(Launcher));
     if (!l) return NULL;
 
     /* Initialize SDL */
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS) < 0) {
+    profile_begin(PHASE_SDL_INIT);
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_TIMER) < 0) {
         fprintf(stderr, "SDL_Init failed: %s\n", SDL_GetError());
         free(l);
         return NULL;
@@ -792,92 +5778,59 @@ static Launcher *launcher_create(void) {
         return NULL;
     }
 
-    /* Get display size */
-    SDL_DisplayMode dm;
-    if (SDL_GetCurrentDisplayMode(0, &dm) == 0) {
-        l->width = dm.w;
-        l->height = dm.h;
-    } else {
-        l->width = 1920;
-        l->height = 1080;
-    }
-    /* Create window - use borderless fullscreen for better compositor compatibility */
-    l->window = SDL_CreateWindow("TvStreamer",
-                                  0, 0,
-                                  l->width, l->height,
-                                  SDL_WINDOW_BORDERLESS | SDL_WINDOW_SHOWN);
+    profile_end(PHASE_SDL_INIT);
 
-    /* Get actual window size after creation */
-    int actual_w, actual_h;
-    SDL_GetWindowSize(l->window, &actual_w, &actual_h);
-    l->width = actual_w;
-    l->height = actual_h;
-    if (!l->window) {
-        fprintf(stderr, "SDL_CreateWindow failed: %s\n", SDL_GetError());
+    /* Window and renderer for the backend main() picked */
+    profile_begin(PHASE_WINDOW);
+    l->backend = display_backend;
+    if (!video_open(l, 1)) {
         launcher_destroy(l);
         return NULL;
     }
+    profile_end(PHASE_WINDOW);
 
-    /* Create renderer with VSync */
-    l->renderer = SDL_CreateRenderer(l->window, -1,
-                                      SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
-    if (!l->renderer) {
-        /* Try software renderer as fallback */
-        l->renderer = SDL_CreateRenderer(l->window, -1, SDL_RENDERER_SOFTWARE);
-    }
-    if (!l->renderer) {
-        fprintf(stderr, "SDL_CreateRenderer failed: %s\n", SDL_GetError());
-        launcher_destroy(l);
-        return NULL;
-    }
+    /* First pixel right away - everything else arrives from the startup worker */
+    profile_begin(PHASE_FIRST_PIXEL);
+    SDL_SetRenderDrawColor(l->renderer, COL_BG);
+    SDL_RenderClear(l->renderer);
+    SDL_RenderPresent(l->renderer);
+    profile_end(PHASE_FIRST_PIXEL);
 
-    SDL_SetRenderDrawBlendMode(l->renderer, SDL_BLENDMODE_BLEND);
-    SDL_ShowCursor(SDL_DISABLE);
+    /* Initialize state */
+    l->selected = 0;
+    l->settings_selected = 0;
+    l->last_minute = -1;
 
-    /* Load fonts */
-    l->font_clock = load_font(NULL, 180);
-    l->font_date = load_font(NULL, 42);
-    l->font_tile = load_font(NULL, 22);
-    l->font_stat_value = load_font(NULL, 36);
-    l->font_stat_label = load_font(NULL, 16);
-    l->font_icon = load_nerd_font(42);
-    l->font_icon_small = load_nerd_font(22);
+    /* Wake events let the main loop block instead of polling */
+    l->wake_event = SDL_RegisterEvents(1);
+    l->clock_timer = SDL_AddTimer(ms_until_next_minute(), clock_timer_func, l);
 
-    if (!l->font_clock) {
-        fprintf(stderr, "Failed to load clock font\n");
-        launcher_destroy(l);
-        return NULL;
-    }
-    if (!l->font_tile) {
-        fprintf(stderr, "Failed to load tile font\n");
-        launcher_destroy(l);
-        return NULL;
-    }
-    if (!l->font_icon) {
-        fprintf(stderr, "Warning: Failed to load Nerd Font for icons, using fallback\n");
-        /* Use tile font as fallback for icons */
-        l->font_icon = l->font_tile;
-        l->font_icon_small = l->font_stat_label;
+    /* Fonts, wallpaper and glyphs load on a worker; without one do it inline */
+    if (!startup_begin(l)) {
+        startup_thread_func(l);
+        if (!startup_finish(l)) {
+            launcher_destroy(l);
+            return NULL;
+        }
     }
 
-    /* Load background */
-    l->background = load_background(l);
-
-    /* Calculate layout */
-    calc_layout(l);
+    /* Start child supervisor */
+    if (!supervisor_start(l)) {
+        fprintf(stderr, "Warning: child supervisor unavailable, apps will launch without hiding\n");
+    }
 
-    /* Cache surfaces */
-    cache_surfaces(l);
+    /* Start control socket - a second instance or an unwritable runtime dir just goes without */
+    if (control_enabled) control_start(l);
 
-    /* Initialize state */
-    l->selected = 0;
-    l->settings_selected = 0;
-    l->needs_redraw = 1;
-    l->last_minute = -1;
+    /* Start remote input - without /dev/input access remotes go through SDL like keyboards */
+    if (remote_grab && !remote_start(l)) {
+        fprintf(stderr, "Warning: remote input thread failed to start\n");
+    }
 
     /* Start stats thread */
-    l->stats.running = 1;
-    pthread_create(&l->stats_thread, NULL, stats_thread_func, l);
+    if (!stats_start(l)) {
+        fprintf(stderr, "Warning: stats thread failed to start\n");
+    }
 
     return l;
 }
@@ -886,43 +5839,26 @@ static void launcher_destroy(Launcher *l) {
     if (!l) return;
 
     /* Stop stats thread */
-    l->stats.running = 0;
-    pthread_join(l->stats_thread, NULL);
-
-    /* Free textures */
-    if (l->background) SDL_DestroyTexture(l->background);
-    if (l->tile_bg_normal) SDL_DestroyTexture(l->tile_bg_normal);
-    if (l->tile_bg_selected) SDL_DestroyTexture(l->tile_bg_selected);
-    if (l->stats_bar_bg) SDL_DestroyTexture(l->stats_bar_bg);
-    if (l->settings_bg_normal) SDL_DestroyTexture(l->settings_bg_normal);
-    if (l->settings_bg_selected) SDL_DestroyTexture(l->settings_bg_selected);
+    stats_stop(l);
 
-    for (int i = 0; i < NUM_APPS; i++) {
-        if (l->tile_labels[i]) SDL_DestroyTexture(l->tile_labels[i]);
-        if (l->tile_icons[i]) SDL_DestroyTexture(l->tile_icons[i]);
-        if (l->tile_icons_dim[i]) SDL_DestroyTexture(l->tile_icons_dim[i]);
-    }
+    /* Wait out a startup still in flight - it owns the fonts until it's done */
+    startup_discard(&l->startup);
+    bg_refresh_discard(&l->bg_refresh);
 
-    for (int i = 0; i < 4; i++) {
-        if (l->stat_labels[i]) SDL_DestroyTexture(l->stat_labels[i]);
-        if (l->stat_icons[i]) SDL_DestroyTexture(l->stat_icons[i]);
-    }
+    if (l->clock_timer) SDL_RemoveTimer(l->clock_timer);
+    if (l->idle_timer) SDL_RemoveTimer(l->idle_timer);
+    control_stop(l);
+    remote_stop(l);
+    warm_stop(l);
+    supervisor_stop(l);
 
-    if (l->settings_icon) SDL_DestroyTexture(l->settings_icon);
-    if (l->settings_icon_dim) SDL_DestroyTexture(l->settings_icon_dim);
-    if (l->help_text) SDL_DestroyTexture(l->help_text);
+    release_scene(l);
+    catalog_free(&l->catalog);
 
-    /* Free fonts */
-    if (l->font_clock) TTF_CloseFont(l->font_clock);
-    if (l->font_date) TTF_CloseFont(l->font_date);
-    if (l->font_tile) TTF_CloseFont(l->font_tile);
-    if (l->font_stat_value) TTF_CloseFont(l->font_stat_value);
-    if (l->font_stat_label) TTF_CloseFont(l->font_stat_label);
-    if (l->font_icon) TTF_CloseFont(l->font_icon);
-    if (l->font_icon_small) TTF_CloseFont(l->font_icon_small);
+    /* Free fonts - the registry closes each handle once, even where font_icon aliases font_tile */
+    font_registry_close(&l->fonts);
 
-    if (l->renderer) SDL_DestroyRenderer(l->renderer);
-    if (l->window) SDL_DestroyWindow(l->window);
+    video_close(l);
 
     IMG_Quit();
     TTF_Quit();
@@ -933,61 +5869,283 @@ static void launcher_destroy(Launcher *l) {
 
 /* ============ Main Loop ============ */
 
-static void run(Launcher *l) {
-    /* Initial draw */
-    draw(l);
-    l->needs_redraw = 0;
+/* Returns the exit status - nonzero when the loop ended on a failure rather than a quit */
+static int run(Launcher *l) {
+    SDL_Event e;
+    Uint32 frame_start = 0;
 
     while (1) {
-        /* Handle events */
-        if (!handle_events(l)) break;
+        /* Redraw if needed */
+        update_clock(l);
+        int animating = l->ready && !l->app_running && anim_step(l);
+        if (l->ready && l->dirty && !l->app_running) {
+            draw(l);
+        }
 
-        /* Check if launched app is still running */
-        if (l->app_running) {
-            if (!is_app_running()) {
-                /* App closed - show launcher again */
-                l->app_running = 0;
-                SDL_ShowWindow(l->window);
-                SDL_RaiseWindow(l->window);
-                l->needs_redraw = 1;
-            } else {
-                /* App still running - sleep longer to save CPU */
-                SDL_Delay(200);
-                continue;
+        /*
+         * Mid-tween: poll and let the VSync'd present pace the next frame.
+         * Some drivers report VSync yet return from present at once, so a
+         * frame that came back far too fast is paced here as well.
+         */
+        if (animating) {
+            Uint32 frame = SDL_GetTicks() - frame_start;
+            if (!l->vsync || frame < ANIM_VSYNC_MIN_MS) {
+                SDL_Delay(frame < ANIM_FRAME_MS ? ANIM_FRAME_MS - frame : 0);
+            }
+            frame_start = SDL_GetTicks();
+            int quit = 0;
+            while (!quit && SDL_PollEvent(&e)) {
+                quit = !handle_event(l, &e);
             }
+            if (quit) break;
+            continue;
         }
 
-        /* Check clock minute change */
-        time_t now = time(NULL);
-        struct tm *t = localtime(&now);
-        int current_minute = t->tm_hour * 60 + t->tm_min;
-        if (current_minute != l->last_minute) {
-            l->last_minute = current_minute;
-            l->needs_redraw = 1;
+        /*
+         * Block until something happens. Input, stats, child exit and the
+         * clock timer all arrive as events - the timeout only backs up the
+         * clock timer should it be delayed, and a worker's lost wake.
+         */
+        int worker = l->startup.started || l->bg_refresh.started;
+        int timeout = worker ? STARTUP_POLL_MS : (int)ms_until_next_minute();
+        int woke = SDL_WaitEventTimeout(&e, timeout);
+        profile_wakeup();
+        if (woke) {
+            if (!handle_event(l, &e)) break;
+            /* Drain whatever else queued up before redrawing once */
+            int quit = 0;
+            while (!quit && SDL_PollEvent(&e)) {
+                quit = !handle_event(l, &e);
+            }
+            if (quit) break;
         }
 
-        /* Check stats change */
-        if (l->stats.changed) {
-            l->stats.changed = 0;
-            l->needs_redraw = 1;
-        }
+        /* The worker's wake never made it into the queue */
+        if (atomic_load(&l->startup.lost_wake) && !startup_finish(l)) break;
+        if (atomic_load(&l->bg_refresh.lost_wake)) bg_refresh_finish(l);
+    }
+    return l->failed ? 1 : 0;
+}
 
-        /* Redraw if needed */
-        if (l->needs_redraw) {
-            draw(l);
-            l->needs_redraw = 0;
+/* ============ Benchmark ============ */
+
+/*
+ * --bench drives the real scene headless: full redraws, stats ticks, key
+ * navigation and suspend/resume cycles, each timed per iteration. The
+ * stats thread is stopped so that ticks come only from here. With
+ * --backend kmsdrm it runs on the display instead, and every resume
+ * includes handing DRM master back and forth.
+ */
+#define BENCH_DEFAULT_ITERS     500
+#define BENCH_RESUME_DIVISOR    20      /* resume cycles are far heavier than frames */
+
+static const SDL_Keycode bench_keys[] = {
+    SDLK_RIGHT, SDLK_RIGHT, SDLK_DOWN, SDLK_LEFT, SDLK_UP, SDLK_UP, SDLK_DOWN, SDLK_LEFT,
+};
+
+typedef struct {
+    const char *name;
+    Uint32 *us;
+    int n;
+    Uint64 total_ns;
+} BenchRun;
+
+static void bench_add(BenchRun *b, Uint64 start) {
+    Uint64 ns = clock_ns(CLOCK_MONOTONIC) - start;
+    b->us[b->n++] = (Uint32)(ns / 1000);
+    b->total_ns += ns;
+}
+
+static void bench_print(BenchRun *b) {
+    double pct[4];
+    double secs = b->total_ns / 1e9;
+    profile_percentiles(b->us, b->n, pct);
+    printf("%-10s %6d  %9.1f/s  p50 %7.3f  p95 %7.3f  p99 %7.3f  max %7.3f ms\n",
+           b->name, b->n, secs > 0 ? b->n / secs : 0.0, pct[0], pct[1], pct[2], pct[3]);
+}
+
+/* Only startup completion is let through - warm timers and the rest are dropped */
+static int bench_wait_ready(Launcher *l) {
+    SDL_Event e;
+    while (!l->ready) {
+        if (atomic_load(&l->startup.lost_wake) && !startup_finish(l)) return 0;
+        if (!SDL_WaitEventTimeout(&e, STARTUP_POLL_MS)) continue;
+        if (e.type == SDL_QUIT) return 0;
+        if (e.type == l->wake_event && e.user.code == WAKE_CONTROL) control_discard(&e.user);
+        if (e.type == l->wake_event && e.user.code == WAKE_STARTUP_DONE && !handle_event(l, &e)) return 0;
+    }
+    return 1;
+}
+
+static int bench_run(Launcher *l, int iters) {
+    SDL_RendererInfo info;
+    int resumes = iters / BENCH_RESUME_DIVISOR > 3 ? iters / BENCH_RESUME_DIVISOR : 3;
+    BenchRun runs[] = {
+        {"redraw", NULL, 0, 0},
+        {"stats", NULL, 0, 0},
+        {"navigate", NULL, 0, 0},
+        {"resume", NULL, 0, 0},
+    };
+    int num_runs = (int)(sizeof(runs) / sizeof(runs[0]));
+    int ok = 0;
+
+    stats_stop(l);
+    if (!bench_wait_ready(l)) {
+        fprintf(stderr, "Benchmark: startup failed\n");
+        return 0;
+    }
+
+    for (int i = 0; i < num_runs; i++) {
+        runs[i].us = malloc(sizeof(Uint32) * (size_t)(iters > resumes ? iters : resumes));
+        if (!runs[i].us) goto out;
+    }
+
+    if (SDL_GetRendererInfo(l->renderer, &info) != 0) info.name = "unknown";
+    printf("bench: %s backend (%s video), %dx%d, %s renderer, %d apps, %d iterations\n",
+           backend_names[l->backend], SDL_GetCurrentVideoDriver(), l->width, l->height,
+           info.name, l->catalog.num_apps, iters);
+
+    /* The one startup this process had, as --profile records it */
+    printf("startup    %.1f ms to first frame:", (g_profile.ready_at - g_profile.t0) / 1e6);
+    for (int i = 0; i < NUM_PHASES; i++) {
+        if (!g_profile.phase_end[i]) continue;
+        printf(" %s %.1f", phase_names[i], (g_profile.phase_end[i] - g_profile.phase_start[i]) / 1e6);
+    }
+    printf("\n");
+
+    /* Full-scene recomposite */
+    for (int i = 0; i < iters; i++) {
+        Uint64 t = clock_ns(CLOCK_MONOTONIC);
+        invalidate(l, REGION_ALL);
+        draw(l);
+        bench_add(&runs[0], t);
+    }
+
+    /* Sample, publish and repaint the stats bar - the stats thread loop plus its wake */
+    ProcSampler ps;
+    StatsSample cur;
+    sampler_open(&ps);
+    memset(&cur, 0, sizeof(cur));
+    for (int i = 0; i < iters; i++) {
+        Uint64 t = clock_ns(CLOCK_MONOTONIC);
+        stats_sample(&ps, &cur);
+        cur.timestamp = (Uint64)i + 1;
+        cur.columns = (Uint32)i + 1;
+        stats_publish(&l->stats.published, &cur);
+        SDL_UserEvent wake = {.code = WAKE_STATS};
+        handle_wake(l, &wake);
+        draw(l);
+        bench_add(&runs[1], t);
+    }
+    sampler_close(&ps);
+
+    /* Key to the first frame of its transition; the tween is then settled untimed */
+    for (int i = 0; i < iters; i++) {
+        SDL_Event e;
+        memset(&e, 0, sizeof(e));
+        e.type = SDL_KEYDOWN;
+        e.key.keysym.sym = bench_keys[i % (int)(sizeof(bench_keys) / sizeof(bench_keys[0]))];
+
+        Uint64 t = clock_ns(CLOCK_MONOTONIC);
+        handle_event(l, &e);
+        anim_step(l);
+        draw(l);
+        bench_add(&runs[2], t);
+
+        anim_reset(l);
+        invalidate(l, REGION_ALL);
+        draw(l);
+    }
+
+    /* What an app exit costs: the whole scene and its fonts rebuilt, on KMSDRM the display too */
+    for (int i = 0; i < resumes; i++) {
+        Uint64 t = clock_ns(CLOCK_MONOTONIC);
+        launcher_hide(l);
+        if (!launcher_wake(l) || !bench_wait_ready(l)) {
+            fprintf(stderr, "Benchmark: resume failed\n");
+            goto out;
         }
+        draw(l);
+        bench_add(&runs[3], t);
+    }
+
+    for (int i = 0; i < num_runs; i++) {
+        bench_print(&runs[i]);
+    }
+    ok = 1;
 
-        /* Sleep to save CPU - event driven, max 20 FPS polling */
-        SDL_Delay(50);
+out:
+    for (int i = 0; i < num_runs; i++) {
+        free(runs[i].us);
     }
+    return ok;
 }
 
 /* ============ Entry Point ============ */
 
-int main(int argc __attribute__((unused)), char *argv[] __attribute__((unused))) {
-    /* Handle signals */
-    signal(SIGCHLD, SIG_IGN);
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [--backend auto|windowed|kmsdrm] [--profile] [--bench [N]] [--idle M] [--blank M]\n"
+                    "       [--no-remote-grab] [--version]\n"
+                    "  --backend   windowed in a session, kmsdrm straight to the display (default auto)\n"
+                    "  --profile   print startup and frame timing to stderr on exit\n"
+                    "  --bench N   run N headless iterations of each benchmark and exit\n"
+                    "  --idle M    dim to a clock after M minutes without input (default %d, 0 = never)\n"
+                    "  --blank M   blank the display M minutes after dimming (default never)\n"
+                    "  --no-remote-grab  leave TV remotes to SDL instead of reading them directly\n",
+            prog, IDLE_DEFAULT_MIN);
+}
+
+int main(int argc, char *argv[]) {
+    int bench_iters = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--profile") == 0) {
+            g_profile.enabled = 1;
+        } else if (strcmp(argv[i], "--bench") == 0) {
+            bench_iters = BENCH_DEFAULT_ITERS;
+            if (i + 1 < argc && atoi(argv[i + 1]) > 0) bench_iters = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--backend") == 0 && i + 1 < argc && backend_parse(argv[i + 1]) >= 0) {
+            display_backend = backend_parse(argv[++i]);
+        } else if (strcmp(argv[i], "--idle") == 0 && i + 1 < argc) {
+            idle_dim_ms = idle_parse_minutes(argv[++i]);
+        } else if (strcmp(argv[i], "--blank") == 0 && i + 1 < argc) {
+            idle_blank_ms = idle_parse_minutes(argv[++i]);
+        } else if (strcmp(argv[i], "--no-remote-grab") == 0) {
+            remote_grab = 0;
+        } else if (strcmp(argv[i], "--version") == 0) {
+            printf("tvstreamer-launcher %s\n", VERSION);
+            return 0;
+        } else {
+            usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0 ? 0 : 1;
+        }
+    }
+    g_profile.t0 = profile_now(CLOCK_MONOTONIC);
+
+    /* Headless unless benchmarking the display itself, and never held back by VSync */
+    if (bench_iters) {
+        g_profile.enabled = 1;
+        if (display_backend != BACKEND_KMSDRM) {
+            setenv("SDL_VIDEODRIVER", "offscreen", 0);
+            setenv("SDL_RENDER_DRIVER", "software", 0);
+        }
+        setenv("SDL_RENDER_VSYNC", "0", 0);
+        /* The user's session keeps its remotes and its control socket */
+        control_enabled = 0;
+        remote_grab = 0;
+    }
+    display_backend = backend_select(display_backend);
+
+    /*
+     * Keep SIGCHLD blocked in every thread (SDL's included) so the child
+     * supervisor can take it through a signalfd. Children are reaped by
+     * the supervisor rather than auto-reaped with SIG_IGN, which would
+     * hide the launched app's exit.
+     */
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &mask, NULL);
 
     Launcher *l = launcher_create();
     if (!l) {
@@ -996,8 +6154,15 @@ int main(int argc __attribute__((unused)), char *argv[] __attribute__((unused)))
     }
 
     g_launcher = l;
-    run(l);
+    if (bench_iters) {
+        int ok = bench_run(l, bench_iters);
+        launcher_destroy(l);
+        return ok ? 0 : 1;
+    }
+
+    int status = run(l);
+    profile_report();
     launcher_destroy(l);
 
-    return 0;
+    return status;
 }